@@ -1,5 +1,6 @@
 #include "mainwindow.h"
 #include "./ui_mainwindow.h"
+#include "matrix_table_model.h"
 #include "randomization.h"
 #include "set_matrix_size.h"
 #include "helpers.h"
@@ -81,6 +82,20 @@ MainWindow::MainWindow(QWidget *parent)
 {
     ui->setupUi(this);
 
+    modelA_MatrixOperations = new MatrixTableModel(this);
+    modelB_MatrixOperations = new MatrixTableModel(this);
+    modelC_MatrixOperations = new MatrixTableModel(this);
+    ui->table_A_matrix_operations->setModel(modelA_MatrixOperations);
+    ui->table_B_matrix_operations->setModel(modelB_MatrixOperations);
+    ui->table_C_matrix_operations->setModel(modelC_MatrixOperations);
+
+    modelA_SLESolver = new MatrixTableModel(this);
+    modelB_SLESolver = new MatrixTableModel(this);
+    modelX_SLESolver = new VectorTableModel(this);
+    ui->table_A_sle_solver->setModel(modelA_SLESolver);
+    ui->table_B_sle_solver->setModel(modelB_SLESolver);
+    ui->table_Solution_sle_solver->setModel(modelX_SLESolver);
+
     createMatrixAMenu_MatrixOperations();
     createMatrixBMenu_MatrixOperations();
     createMatrixCMenu_MatrixOperations();
@@ -265,11 +280,6 @@ void MainWindow::createMatrixA_MatrixOperations()
     }
 }
 
-void MainWindow::setCellA_MatrixOperations(int rowIndex, int columnIndex)
-{
-    A->at(rowIndex, columnIndex) = ui->table_A_matrix_operations->item(rowIndex, columnIndex)->text().toDouble();
-}
-
 void MainWindow::loadMatrixB_MatrixOperations()
 {
     try
@@ -441,11 +451,6 @@ void MainWindow::createMatrixB_MatrixOperations()
     }
 }
 
-void MainWindow::setCellB_MatrixOperations(int rowIndex, int columnIndex)
-{
-    B->at(rowIndex, columnIndex) = ui->table_B_matrix_operations->item(rowIndex, columnIndex)->text().toDouble();
-}
-
 void MainWindow::saveMatrixC_MatrixOperations()
 {
     try
@@ -669,11 +674,6 @@ void MainWindow::createMatrixA_SLESolver()
     }
 }
 
-void MainWindow::setCellA_SLESolver(int rowIndex, int columnIndex)
-{
-    sle.getMatrixA()[rowIndex][columnIndex] = ui->table_A_sle_solver->item(rowIndex, columnIndex)->text().toDouble();
-}
-
 void MainWindow::loadMatrixB_SLESolver()
 {
     try
@@ -822,11 +822,6 @@ void MainWindow::createMatrixB_SLESolver()
     }
 }
 
-void MainWindow::setCellB_SLESolver(int rowIndex, int columnIndex)
-{
-    sle.getMatrixB()[rowIndex][columnIndex] = ui->table_B_sle_solver->item(rowIndex, columnIndex)->text().toDouble();
-}
-
 void MainWindow::saveVectorX_SLESolver()
 {
     try
@@ -846,7 +841,8 @@ void MainWindow::solveVectorX_SLESolver()
 {
     try
     {
-        sle.solve();
+        modelX_SLESolver->setVector(nullptr);
+        sle.solveGaussianElimination();
 
         updateVectorX_SLESolver();
     }
@@ -858,47 +854,17 @@ void MainWindow::solveVectorX_SLESolver()
 
 void MainWindow::updateMatrixA_MatrixOperations()
 {
-    ui->table_A_matrix_operations->setRowCount(A->getNumRows());
-    ui->table_A_matrix_operations->setColumnCount(A->getNumColumns());
-
-    for (size_t i = 0; i < A->getNumRows(); ++i)
-    {
-        for (size_t j = 0; j < A->getNumColumns(); ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg((A->at(i, j))));
-            ui->table_A_matrix_operations->setItem(i, j, item);
-        }
-    }
+    modelA_MatrixOperations->setMatrix(A.get());
 }
 
 void MainWindow::updateMatrixB_MatrixOperations()
 {
-    ui->table_B_matrix_operations->setRowCount(B->getNumRows());
-    ui->table_B_matrix_operations->setColumnCount(B->getNumColumns());
-
-    for (size_t i = 0; i < B->getNumRows(); ++i)
-    {
-        for (size_t j = 0; j < B->getNumColumns(); ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(B->at(i, j)));
-            ui->table_B_matrix_operations->setItem(i, j, item);
-        }
-    }
+    modelB_MatrixOperations->setMatrix(B.get());
 }
 
 void MainWindow::updateMatrixC_MatrixOperations()
 {
-    ui->table_C_matrix_operations->setRowCount(C->getNumRows());
-    ui->table_C_matrix_operations->setColumnCount(C->getNumColumns());
-
-    for (size_t i = 0; i < C->getNumRows(); ++i)
-    {
-        for (size_t j = 0; j < C->getNumColumns(); ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(C->at(i, j)));
-            ui->table_C_matrix_operations->setItem(i, j, item);
-        }
-    }
+    modelC_MatrixOperations->setMatrix(C.get());
 }
 
 void MainWindow::createMatrixAMenu_MatrixOperations()
@@ -926,7 +892,6 @@ void MainWindow::createMatrixAMenu_MatrixOperations()
     connect(actions["remove_column"], &QAction::triggered, this, &MainWindow::removeColumnFromMatrixA_MatrixOperations);
     connect(actions["randomize"], &QAction::triggered, this, &MainWindow::randomizeA_MatrixOperations);
     connect(actions["create_matrix"], &QAction::triggered, this, &MainWindow::createMatrixA_MatrixOperations);
-    connect(ui->table_A_matrix_operations, &QTableWidget::cellChanged, this, &MainWindow::setCellA_MatrixOperations);
 
     ui->push_button_matrix_A_matrix_operations->setMenu(matrixToolset);
 }
@@ -956,7 +921,6 @@ void MainWindow::createMatrixBMenu_MatrixOperations()
     connect(actions["remove_column"], &QAction::triggered, this, &MainWindow::removeColumnFromMatrixB_MatrixOperations);
     connect(actions["randomize"], &QAction::triggered, this, &MainWindow::randomizeB_MatrixOperations);
     connect(actions["create_matrix"], &QAction::triggered, this, &MainWindow::createMatrixB_MatrixOperations);
-    connect(ui->table_B_matrix_operations, &QTableWidget::cellChanged, this, &MainWindow::setCellB_MatrixOperations);
 
     ui->push_button_matrix_B_matrix_operations->setMenu(matrixToolset);
 }
@@ -1001,49 +965,23 @@ void MainWindow::createMatrixCMenu_MatrixOperations()
 
     ui->push_button_matrix_C_matrix_operations->setMenu(matrixToolset);
 
-    ui->table_C_matrix_operations->setEditTriggers(QTableWidget::NoEditTriggers);
+    ui->table_C_matrix_operations->setEditTriggers(QTableView::NoEditTriggers);
+    modelC_MatrixOperations->setEditable(false);
 }
 
 void MainWindow::updateMatrixA_SLESolver()
 {
-    ui->table_A_sle_solver->setRowCount(sle.getMatrixA().getNumRows());
-    ui->table_A_sle_solver->setColumnCount(sle.getMatrixA().getNumColumns());
-
-    for (size_t i = 0; i < sle.getMatrixA().getNumRows(); ++i)
-    {
-        for (size_t j = 0; j < sle.getMatrixA().getNumColumns(); ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(sle.getMatrixA()[i][j]));
-            ui->table_A_sle_solver->setItem(i, j, item);
-        }
-    }
+    modelA_SLESolver->setMatrix(&sle.getMatrixA());
 }
 
 void MainWindow::updateMatrixB_SLESolver()
 {
-    ui->table_B_sle_solver->setRowCount(sle.getMatrixB().getNumRows());
-    ui->table_B_sle_solver->setColumnCount(sle.getMatrixB().getNumColumns());
-
-    for (size_t i = 0; i < sle.getMatrixB().getNumRows(); ++i)
-    {
-        for (size_t j = 0; j < sle.getMatrixB().getNumColumns(); ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(sle.getMatrixB()[i][j]));
-            ui->table_B_sle_solver->setItem(i, j, item);
-        }
-    }
+    modelB_SLESolver->setMatrix(&sle.getMatrixB());
 }
 
 void MainWindow::updateVectorX_SLESolver()
 {
-    ui->table_Solution_sle_solver->setRowCount(sle.getVectorX().size());
-    ui->table_Solution_sle_solver->setColumnCount(1);
-
-    for (size_t i = 0; i < sle.getVectorX().size(); ++i)
-    {
-        QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(sle.getVectorX()[i]));
-        ui->table_Solution_sle_solver->setItem(i, 0, item);
-    }
+    modelX_SLESolver->setVector(&sle.getVectorX());
 }
 
 void MainWindow::createMatrixAMenu_SLESolver()
@@ -1071,7 +1009,6 @@ void MainWindow::createMatrixAMenu_SLESolver()
     connect(actions["remove_column"], &QAction::triggered, this, &MainWindow::removeColumnFromMatrixA_SLESolver);
     connect(actions["randomize"], &QAction::triggered, this, &MainWindow::randomizeA_SLESolver);
     connect(actions["create_matrix"], &QAction::triggered, this, &MainWindow::createMatrixA_SLESolver);
-    connect(ui->table_A_sle_solver, &QTableWidget::cellChanged, this, &MainWindow::setCellA_SLESolver);
 
     ui->push_button_matrix_A_sle_solver->setMenu(matrixToolset);
 }
@@ -1101,7 +1038,6 @@ void MainWindow::createMatrixBMenu_SLESolver()
     connect(actions["remove_column"], &QAction::triggered, this, &MainWindow::removeColumnFromMatrixB_SLESolver);
     connect(actions["randomize"], &QAction::triggered, this, &MainWindow::randomizeB_SLESolver);
     connect(actions["create_matrix"], &QAction::triggered, this, &MainWindow::createMatrixB_SLESolver);
-    connect(ui->table_B_sle_solver, &QTableWidget::cellChanged, this, &MainWindow::setCellB_SLESolver);
 
     ui->push_button_matrix_B_sle_solver->setMenu(matrixToolset);
 }
@@ -1131,5 +1067,6 @@ void MainWindow::createVectorXMenu_SLESolver()
 
     ui->push_button_solution_sle_solver->setMenu(matrixToolset);
 
-    ui->table_Solution_sle_solver->setEditTriggers(QTableWidget::NoEditTriggers);
+    ui->table_Solution_sle_solver->setEditTriggers(QTableView::NoEditTriggers);
+    modelX_SLESolver->setEditable(false);
 }
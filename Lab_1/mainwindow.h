@@ -12,6 +12,8 @@ namespace Ui { class MainWindow; }
 QT_END_NAMESPACE
 
 class QPushButton;
+class MatrixTableModel;
+class VectorTableModel;
 
 class MainWindow : public QMainWindow
 {
@@ -30,7 +32,6 @@ private slots:
     void removeColumnFromMatrixA_MatrixOperations();
     void randomizeA_MatrixOperations();
     void createMatrixA_MatrixOperations();
-    void setCellA_MatrixOperations(int rowIndex, int columnIndex);
 
     void loadMatrixB_MatrixOperations();
     void saveMatrixB_MatrixOperations();
@@ -40,7 +41,6 @@ private slots:
     void removeColumnFromMatrixB_MatrixOperations();
     void randomizeB_MatrixOperations();
     void createMatrixB_MatrixOperations();
-    void setCellB_MatrixOperations(int rowIndex, int columnIndex);
 
     void saveMatrixC_MatrixOperations();
     void addMatrices_MatrixOperations();
@@ -55,7 +55,6 @@ private slots:
     void removeColumnFromMatrixA_SLESolver();
     void randomizeA_SLESolver();
     void createMatrixA_SLESolver();
-    void setCellA_SLESolver(int rowIndex, int columnIndex);
 
     void loadMatrixB_SLESolver();
     void saveMatrixB_SLESolver();
@@ -65,7 +64,6 @@ private slots:
     void removeColumnFromMatrixB_SLESolver();
     void randomizeB_SLESolver();
     void createMatrixB_SLESolver();
-    void setCellB_SLESolver(int rowIndex, int columnIndex);
 
     void saveVectorX_SLESolver();
     void solveVectorX_SLESolver();
@@ -90,6 +88,14 @@ private:
 private:
     Ui::MainWindow *ui;
 
+    MatrixTableModel* modelA_MatrixOperations;
+    MatrixTableModel* modelB_MatrixOperations;
+    MatrixTableModel* modelC_MatrixOperations;
+
+    MatrixTableModel* modelA_SLESolver;
+    MatrixTableModel* modelB_SLESolver;
+    VectorTableModel* modelX_SLESolver;
+
     std::unique_ptr<Matrix> A;
     std::unique_ptr<Matrix> B;
     std::unique_ptr<Matrix> C;
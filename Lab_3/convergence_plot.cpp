@@ -0,0 +1,158 @@
+#include "convergence_plot.h"
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QTimer>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+constexpr int REFRESH_INTERVAL = 33;
+constexpr int MARGIN_LEFT = 60;
+constexpr int MARGIN_RIGHT = 10;
+constexpr int MARGIN_TOP = 10;
+constexpr int MARGIN_BOTTOM = 25;
+constexpr double MIN_RESIDUAL = 1e-300;
+}
+
+ConvergencePlot::ConvergencePlot(QWidget *parent)
+    : QWidget(parent)
+{
+    timer = new QTimer(this);
+    timer->setInterval(REFRESH_INTERVAL);
+    connect(timer, &QTimer::timeout, this, &ConvergencePlot::poll);
+}
+
+void ConvergencePlot::setSource(std::shared_ptr<Telemetry> source)
+{
+    poll();
+    this->source = std::move(source);
+
+    if (this->source)
+        timer->start();
+    else
+        timer->stop();
+}
+
+void ConvergencePlot::clear()
+{
+    points.clear();
+    update();
+}
+
+QSize ConvergencePlot::sizeHint() const
+{
+    return QSize(400, 150);
+}
+
+void ConvergencePlot::poll()
+{
+    if (!source)
+        return;
+
+    size_t numPoints = points.size();
+    source->drain([this](const SolverProgress& state)
+    {
+        if (state.stage == SolverStage::Iteration)
+            points.push_back({ state.step, std::max(std::abs(state.residual), MIN_RESIDUAL) });
+    });
+
+    if (points.size() != numPoints)
+        update();
+}
+
+void ConvergencePlot::paintEvent(QPaintEvent* /*event*/)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().base());
+
+    QRect area(MARGIN_LEFT, MARGIN_TOP, width() - MARGIN_LEFT - MARGIN_RIGHT, height() - MARGIN_TOP - MARGIN_BOTTOM);
+    if ((area.width() <= 0) || (area.height() <= 0))
+        return;
+
+    painter.setPen(palette().color(QPalette::Text));
+    painter.drawRect(area);
+
+    if (points.empty())
+    {
+        painter.drawText(area, Qt::AlignCenter, tr("Residual per iteration"));
+        return;
+    }
+
+    double minLog = std::numeric_limits<double>::max();
+    double maxLog = std::numeric_limits<double>::lowest();
+    for (const Point& point : points)
+    {
+        double value = std::log10(point.residual);
+        minLog = std::min(minLog, value);
+        maxLog = std::max(maxLog, value);
+    }
+
+    minLog = std::floor(minLog);
+    maxLog = std::max(std::ceil(maxLog), minLog + 1.0);
+
+    double firstIteration = static_cast<double>(points.front().iteration);
+    double lastIteration = std::max(static_cast<double>(points.back().iteration), firstIteration + 1.0);
+
+    auto toX = [&](double iteration)
+    {
+        return area.left() + (iteration - firstIteration) / (lastIteration - firstIteration) * area.width();
+    };
+    auto toY = [&](double residual)
+    {
+        return area.bottom() - (std::log10(residual) - minLog) / (maxLog - minLog) * area.height();
+    };
+
+    QPainterPath path;
+    int column = -1;
+    double columnMin = 0.0;
+    double columnMax = 0.0;
+
+    auto flushColumn = [&]()
+    {
+        if (column < 0)
+            return;
+
+        if (path.elementCount() == 0)
+            path.moveTo(column, toY(columnMax));
+        else
+            path.lineTo(column, toY(columnMax));
+
+        if (columnMin != columnMax)
+            path.lineTo(column, toY(columnMin));
+    };
+
+    for (const Point& point : points)
+    {
+        int x = static_cast<int>(toX(static_cast<double>(point.iteration)));
+        if (x != column)
+        {
+            flushColumn();
+            column = x;
+            columnMin = point.residual;
+            columnMax = point.residual;
+        }
+        else
+        {
+            columnMin = std::min(columnMin, point.residual);
+            columnMax = std::max(columnMax, point.residual);
+        }
+    }
+    flushColumn();
+
+    painter.setRenderHint(QPainter::Antialiasing);
+    painter.setClipRect(area.adjusted(1, 1, 0, 0));
+    painter.setPen(QPen(palette().color(QPalette::Highlight), 1.5));
+    painter.drawPath(path);
+    painter.setClipping(false);
+
+    painter.setPen(palette().color(QPalette::Text));
+    painter.drawText(QRect(0, area.top() - 5, MARGIN_LEFT - 5, 20), Qt::AlignRight | Qt::AlignTop, QString("1e%1").arg(maxLog));
+    painter.drawText(QRect(0, area.bottom() - 15, MARGIN_LEFT - 5, 20), Qt::AlignRight | Qt::AlignBottom, QString("1e%1").arg(minLog));
+    painter.drawText(QRect(area.left(), area.bottom() + 2, area.width(), MARGIN_BOTTOM - 2), Qt::AlignLeft | Qt::AlignTop, QString::number(points.front().iteration));
+    painter.drawText(QRect(area.left(), area.bottom() + 2, area.width(), MARGIN_BOTTOM - 2), Qt::AlignRight | Qt::AlignTop, QString::number(points.back().iteration));
+    painter.drawText(QRect(area.left(), area.bottom() + 2, area.width(), MARGIN_BOTTOM - 2), Qt::AlignHCenter | Qt::AlignTop, tr("Iteration"));
+}
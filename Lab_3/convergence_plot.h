@@ -0,0 +1,46 @@
+#ifndef CONVERGENCEPLOT_H
+#define CONVERGENCEPLOT_H
+
+#include "ring_buffer.h"
+#include "sle.h"
+
+#include <QWidget>
+
+#include <memory>
+#include <vector>
+
+class QTimer;
+
+class ConvergencePlot : public QWidget
+{
+    Q_OBJECT
+
+public:
+    using Telemetry = RingBuffer<SolverProgress>;
+
+    explicit ConvergencePlot(QWidget *parent = nullptr);
+
+    void setSource(std::shared_ptr<Telemetry> source);
+    void clear();
+
+    QSize sizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+
+private slots:
+    void poll();
+
+private:
+    struct Point
+    {
+        size_t iteration;
+        double residual;
+    };
+
+    QTimer* timer;
+    std::shared_ptr<Telemetry> source;
+    std::vector<Point> points;
+};
+
+#endif // CONVERGENCEPLOT_H
@@ -1,20 +1,29 @@
 #include "gauss_seidel_method_tab.h"
 
+#include "matrix_table_model.h"
+#include "matrix_table_view.h"
 #include "set_matrix_size.h"
+#include "matrix_cache.h"
 #include "randomization.h"
+#include "heatmap_dialog.h"
+#include "solver_worker.h"
+#include "convergence_plot.h"
 #include "helpers.h"
 
 #include <QInputDialog>
-#include <QTableWidget>
+#include <QTableView>
 #include <QFileDialog>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QPushButton>
+#include <QProgressBar>
 #include <QLabel>
 #include <QMenu>
 
 namespace
 {
+constexpr size_t TELEMETRY_CAPACITY = 4096;
+
 std::map<std::string, QAction*> createMatrixToolset()
 {
     QFont font;
@@ -55,6 +64,11 @@ std::map<std::string, QAction*> createMatrixToolset()
     action_randomize->setText("Randomize...");
     action_randomize->setFont(font);
 
+    QAction* action_view_heatmap = new QAction();
+    action_view_heatmap->setObjectName("action_view_heatmap");
+    action_view_heatmap->setText("View heatmap...");
+    action_view_heatmap->setFont(font);
+
     QAction* action_create_matrix = new QAction();
     action_create_matrix->setObjectName("action_create_matrix");
     action_create_matrix->setText("Create matrix...");
@@ -69,6 +83,7 @@ std::map<std::string, QAction*> createMatrixToolset()
     actions["remove_column"] = action_remove_column;
     actions["randomize"] = action_randomize;
     actions["create_matrix"] = action_create_matrix;
+    actions["view_heatmap"] = action_view_heatmap;
 
     return actions;
 }
@@ -111,17 +126,23 @@ GaussSeidelMethodTab::GaussSeidelMethodTab(QWidget *parent)
     labelsLayout->addWidget(label_matrix_B, 2);
     labelsLayout->addWidget(label_vector_x, 2);
 
-    QTableWidget* table_matrix_A = new QTableWidget(layout);
+    modelA = new MatrixTableModel(this);
+    MatrixTableView* table_matrix_A = new MatrixTableView(layout);
     table_matrix_A->setObjectName("table_matrix_A");
     table_matrix_A->setFont(font);
+    table_matrix_A->setModel(modelA);
 
-    QTableWidget* table_matrix_B = new QTableWidget(layout);
+    modelB = new MatrixTableModel(this);
+    MatrixTableView* table_matrix_B = new MatrixTableView(layout);
     table_matrix_B->setObjectName("table_matrix_B");
     table_matrix_B->setFont(font);
+    table_matrix_B->setModel(modelB);
 
-    QTableWidget* table_vector_x = new QTableWidget(layout);
+    modelX = new VectorTableModel(this);
+    MatrixTableView* table_vector_x = new MatrixTableView(layout);
     table_vector_x->setObjectName("table_vector_x");
     table_vector_x->setFont(font);
+    table_vector_x->setModel(modelX);
 
     QHBoxLayout* tablesLayout = new QHBoxLayout();
     tablesLayout->setObjectName("tables_layout");
@@ -153,13 +174,43 @@ GaussSeidelMethodTab::GaussSeidelMethodTab(QWidget *parent)
     buttonsLayout->addWidget(button_matrix_B);
     buttonsLayout->addWidget(button_vector_x);
 
+    QProgressBar* progress_bar_solve = new QProgressBar(layout);
+    progress_bar_solve->setObjectName("progress_bar_solve");
+    progress_bar_solve->setFont(font);
+    progress_bar_solve->setVisible(false);
+
+    QPushButton* button_cancel = new QPushButton(layout);
+    button_cancel->setObjectName("button_cancel");
+    button_cancel->setText("Cancel");
+    button_cancel->setFont(font);
+    button_cancel->setVisible(false);
+
+    QHBoxLayout* progressLayout = new QHBoxLayout();
+    progressLayout->setObjectName("progress_layout");
+    progressLayout->addWidget(progress_bar_solve, 1);
+    progressLayout->addWidget(button_cancel);
+
+    plot = new ConvergencePlot(layout);
+    plot->setObjectName("plot_convergence");
+    plot->setFont(font);
+
     verticalLayout->addLayout(labelsLayout);
-    verticalLayout->addLayout(tablesLayout);
+    verticalLayout->addLayout(tablesLayout, 3);
     verticalLayout->addLayout(buttonsLayout);
+    verticalLayout->addWidget(plot, 2);
+    verticalLayout->addLayout(progressLayout);
+
+    worker = new SolverWorker(this);
+    connect(worker, &SolverWorker::progressChanged, this, &GaussSeidelMethodTab::updateSolveProgress);
+    connect(worker, &SolverWorker::finished, this, &GaussSeidelMethodTab::finishSolve);
+    connect(worker, &SolverWorker::cancelled, this, &GaussSeidelMethodTab::stopSolve);
+    connect(worker, &SolverWorker::failed, this, &GaussSeidelMethodTab::failSolve);
+    connect(button_cancel, &QPushButton::clicked, worker, &SolverWorker::cancel);
 }
 
 GaussSeidelMethodTab::~GaussSeidelMethodTab()
 {
+    delete worker;
     delete layout;
 }
 
@@ -171,7 +222,7 @@ void GaussSeidelMethodTab::loadMatrixA()
 
         if (!filepath.isEmpty())
         {
-            sle->setMatrixA(Matrix::readFromFile(filepath.toStdString()));
+            sle->setMatrixA(MatrixCache::instance().load(filepath.toStdString()));
             updateMatrixA();
         }
     }
@@ -312,9 +363,20 @@ void GaussSeidelMethodTab::createMatrixA()
     }
 }
 
-void GaussSeidelMethodTab::setCellA(int rowIndex, int columnIndex)
+void GaussSeidelMethodTab::viewHeatmapA()
 {
-    sle->getMatrixA().at(rowIndex, columnIndex) = layout->findChild<QTableWidget*>("table_matrix_A")->item(rowIndex, columnIndex)->text().toDouble();
+    try
+    {
+        if (sle->getMatrixA().getNumRows() == 0)
+            throw std::runtime_error("Matrix A is empty");
+
+        std::unique_ptr<HeatmapDialog> dialog = std::make_unique<HeatmapDialog>(sle->getMatrixA(), this);
+        dialog->exec();
+    }
+    catch(const std::exception& ex)
+    {
+        helpers::showError(ex.what());
+    }
 }
 
 void GaussSeidelMethodTab::loadMatrixB()
@@ -325,7 +387,7 @@ void GaussSeidelMethodTab::loadMatrixB()
 
         if (!filepath.isEmpty())
         {
-            sle->setMatrixB(Matrix::readFromFile(filepath.toStdString()));
+            sle->setMatrixB(MatrixCache::instance().load(filepath.toStdString()));
             updateMatrixB();
         }
     }
@@ -466,9 +528,20 @@ void GaussSeidelMethodTab::createMatrixB()
     }
 }
 
-void GaussSeidelMethodTab::setCellB(int rowIndex, int columnIndex)
+void GaussSeidelMethodTab::viewHeatmapB()
 {
-    sle->getMatrixB().at(rowIndex, columnIndex) = layout->findChild<QTableWidget*>("table_matrix_B")->item(rowIndex, columnIndex)->text().toDouble();
+    try
+    {
+        if (sle->getMatrixB().getNumRows() == 0)
+            throw std::runtime_error("Matrix B is empty");
+
+        std::unique_ptr<HeatmapDialog> dialog = std::make_unique<HeatmapDialog>(sle->getMatrixB(), this);
+        dialog->exec();
+    }
+    catch(const std::exception& ex)
+    {
+        helpers::showError(ex.what());
+    }
 }
 
 void GaussSeidelMethodTab::saveVectorX()
@@ -488,52 +561,73 @@ void GaussSeidelMethodTab::saveVectorX()
 
 void GaussSeidelMethodTab::updateMatrixA()
 {
-    layout->findChild<QTableWidget*>("table_matrix_A")->setRowCount(sle->getMatrixA().getNumRows());
-    layout->findChild<QTableWidget*>("table_matrix_A")->setColumnCount(sle->getMatrixA().getNumColumns());
-
-    for (size_t i = 0; i < sle->getMatrixA().getNumRows(); ++i)
-    {
-        for (size_t j = 0; j < sle->getMatrixA().getNumColumns(); ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg((sle->getMatrixA().at(i, j))));
-            layout->findChild<QTableWidget*>("table_matrix_A")->setItem(i, j, item);
-        }
-    }
+    modelA->setMatrix(&sle->getMatrixA());
 }
 
 void GaussSeidelMethodTab::updateMatrixB()
 {
-    layout->findChild<QTableWidget*>("table_matrix_B")->setRowCount(sle->getMatrixB().getNumRows());
-    layout->findChild<QTableWidget*>("table_matrix_B")->setColumnCount(sle->getMatrixB().getNumColumns());
+    modelB->setMatrix(&sle->getMatrixB());
+}
+
+void GaussSeidelMethodTab::updateVectorX()
+{
+    modelX->setVector(&sle->getVectorX());
+}
 
-    for (size_t i = 0; i < sle->getMatrixB().getNumRows(); ++i)
+void GaussSeidelMethodTab::solve()
+{
+    try
     {
-        for (size_t j = 0; j < sle->getMatrixB().getNumColumns(); ++j)
+        if (worker->isRunning())
+            return;
+
+        modelX->setVector(nullptr);
+        setSolving(true);
+
+        auto telemetry = std::make_shared<SolverWorker::Telemetry>(TELEMETRY_CAPACITY);
+        plot->clear();
+        plot->setSource(telemetry);
+        worker->setTelemetry(telemetry);
+
+        SLE* system = sle.get();
+        worker->start([system](const CancellationToken& token, const ProgressCallback& progress)
         {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(sle->getMatrixB().at(i, j)));
-            layout->findChild<QTableWidget*>("table_matrix_B")->setItem(i, j, item);
-        }
+            system->solveGaussSeidelMethod(&token, progress);
+        });
+    }
+    catch(const std::exception& ex)
+    {
+        setSolving(false);
+        helpers::showError(ex.what());
     }
 }
 
-void GaussSeidelMethodTab::updateVectorX()
+void GaussSeidelMethodTab::updateSolveProgress(int stage, int step, int numSteps, double residual)
 {
-    layout->findChild<QTableWidget*>("table_vector_x")->setRowCount(sle->getVectorX().size());
-    layout->findChild<QTableWidget*>("table_vector_x")->setColumnCount(1);
-
-    for (size_t i = 0; i < sle->getVectorX().size(); ++i)
-    {
-        QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(sle->getVectorX()[i]));
-        layout->findChild<QTableWidget*>("table_vector_x")->setItem(i, 0, item);
+    QProgressBar* progressBar = layout->findChild<QProgressBar*>("progress_bar_solve");
+    progressBar->setRange(0, numSteps);
+    progressBar->setValue(step);
+
+    switch (static_cast<SolverStage>(stage))
+    {
+    case SolverStage::Elimination:
+        progressBar->setFormat(tr("Elimination: pivot %1 of %2").arg(step + 1).arg(numSteps));
+        break;
+    case SolverStage::BackSubstitution:
+        progressBar->setFormat(tr("Back substitution: row %1 of %2").arg(step + 1).arg(numSteps));
+        break;
+    case SolverStage::Iteration:
+        progressBar->setFormat(tr("Iteration %1, residual %2").arg(step).arg(residual, 0, 'g', 3));
+        break;
     }
 }
 
-void GaussSeidelMethodTab::solve()
+void GaussSeidelMethodTab::finishSolve()
 {
+    setSolving(false);
+
     try
     {
-        sle->solveGaussSeidelMethod();
-
         updateVectorX();
     }
     catch(const std::exception& ex)
@@ -542,6 +636,38 @@ void GaussSeidelMethodTab::solve()
     }
 }
 
+void GaussSeidelMethodTab::stopSolve()
+{
+    setSolving(false);
+}
+
+void GaussSeidelMethodTab::failSolve(const QString& message)
+{
+    setSolving(false);
+    helpers::showError(message.toStdString());
+}
+
+void GaussSeidelMethodTab::setSolving(bool solving)
+{
+    if (!solving)
+    {
+        plot->setSource(nullptr);
+        worker->setTelemetry(nullptr);
+    }
+
+    layout->findChild<QPushButton*>("button_matrix_A")->setEnabled(!solving);
+    layout->findChild<QPushButton*>("button_matrix_B")->setEnabled(!solving);
+    layout->findChild<QPushButton*>("button_vector_x")->setEnabled(!solving);
+    modelA->setEditable(!solving);
+    modelB->setEditable(!solving);
+
+    QProgressBar* progressBar = layout->findChild<QProgressBar*>("progress_bar_solve");
+    progressBar->setRange(0, 0);
+    progressBar->setFormat(QString());
+    progressBar->setVisible(solving);
+    layout->findChild<QPushButton*>("button_cancel")->setVisible(solving);
+}
+
 void GaussSeidelMethodTab::createMatrixAMenu()
 {
     auto actions = createMatrixToolset();
@@ -558,6 +684,8 @@ void GaussSeidelMethodTab::createMatrixAMenu()
     matrixToolset->addSeparator();
     matrixToolset->addAction(actions["randomize"]);
     matrixToolset->addAction(actions["create_matrix"]);
+    matrixToolset->addSeparator();
+    matrixToolset->addAction(actions["view_heatmap"]);
 
     connect(actions["load"], &QAction::triggered, this, &GaussSeidelMethodTab::loadMatrixA);
     connect(actions["save"], &QAction::triggered, this, &GaussSeidelMethodTab::saveMatrixA);
@@ -567,7 +695,7 @@ void GaussSeidelMethodTab::createMatrixAMenu()
     connect(actions["remove_column"], &QAction::triggered, this, &GaussSeidelMethodTab::removeColumnFromMatrixA);
     connect(actions["randomize"], &QAction::triggered, this, &GaussSeidelMethodTab::randomizeA);
     connect(actions["create_matrix"], &QAction::triggered, this, &GaussSeidelMethodTab::createMatrixA);
-    connect(layout->findChild<QTableWidget*>("table_matrix_A"), &QTableWidget::cellChanged, this, &GaussSeidelMethodTab::setCellA);
+    connect(actions["view_heatmap"], &QAction::triggered, this, &GaussSeidelMethodTab::viewHeatmapA);
 
     layout->findChild<QPushButton*>("button_matrix_A")->setMenu(matrixToolset);
 }
@@ -588,6 +716,8 @@ void GaussSeidelMethodTab::createMatrixBMenu()
     matrixToolset->addSeparator();
     matrixToolset->addAction(actions["randomize"]);
     matrixToolset->addAction(actions["create_matrix"]);
+    matrixToolset->addSeparator();
+    matrixToolset->addAction(actions["view_heatmap"]);
 
     connect(actions["load"], &QAction::triggered, this, &GaussSeidelMethodTab::loadMatrixB);
     connect(actions["save"], &QAction::triggered, this, &GaussSeidelMethodTab::saveMatrixB);
@@ -597,7 +727,7 @@ void GaussSeidelMethodTab::createMatrixBMenu()
     connect(actions["remove_column"], &QAction::triggered, this, &GaussSeidelMethodTab::removeColumnFromMatrixB);
     connect(actions["randomize"], &QAction::triggered, this, &GaussSeidelMethodTab::randomizeB);
     connect(actions["create_matrix"], &QAction::triggered, this, &GaussSeidelMethodTab::createMatrixB);
-    connect(layout->findChild<QTableWidget*>("table_matrix_B"), &QTableWidget::cellChanged, this, &GaussSeidelMethodTab::setCellB);
+    connect(actions["view_heatmap"], &QAction::triggered, this, &GaussSeidelMethodTab::viewHeatmapB);
 
     layout->findChild<QPushButton*>("button_matrix_B")->setMenu(matrixToolset);
 }
@@ -628,5 +758,6 @@ void GaussSeidelMethodTab::createVectorXMenu()
 
     layout->findChild<QPushButton*>("button_vector_x")->setMenu(matrixToolset);
 
-    layout->findChild<QTableWidget*>("table_vector_x")->setEditTriggers(QTableWidget::NoEditTriggers);
+    layout->findChild<QTableView*>("table_vector_x")->setEditTriggers(QTableView::NoEditTriggers);
+    modelX->setEditable(false);
 }
@@ -7,6 +7,11 @@
 
 #include <memory>
 
+class MatrixTableModel;
+class VectorTableModel;
+class SolverWorker;
+class ConvergencePlot;
+
 class GaussSeidelMethodTab : public QWidget
 {
     Q_OBJECT
@@ -24,7 +29,7 @@ private slots:
     void removeColumnFromMatrixA();
     void randomizeA();
     void createMatrixA();
-    void setCellA(int rowIndex, int columnIndex);
+    void viewHeatmapA();
 
     void loadMatrixB();
     void saveMatrixB();
@@ -34,10 +39,14 @@ private slots:
     void removeColumnFromMatrixB();
     void randomizeB();
     void createMatrixB();
-    void setCellB(int rowIndex, int columnIndex);
+    void viewHeatmapB();
 
     void saveVectorX();
     void solve();
+    void updateSolveProgress(int stage, int step, int numSteps, double residual);
+    void finishSolve();
+    void stopSolve();
+    void failSolve(const QString& message);
 
 private:
     void updateMatrixA();
@@ -48,8 +57,15 @@ private:
     void createMatrixBMenu();
     void createVectorXMenu();
 
+    void setSolving(bool solving);
+
 private:
     QWidget* layout;
+    MatrixTableModel* modelA;
+    MatrixTableModel* modelB;
+    VectorTableModel* modelX;
+    SolverWorker* worker;
+    ConvergencePlot* plot;
 
     std::unique_ptr<SLE> sle;
 };
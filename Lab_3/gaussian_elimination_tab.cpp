@@ -1,15 +1,21 @@
 #include "gaussian_elimination_tab.h"
 
+#include "matrix_table_model.h"
+#include "matrix_table_view.h"
 #include "set_matrix_size.h"
+#include "matrix_cache.h"
 #include "randomization.h"
+#include "heatmap_dialog.h"
+#include "solver_worker.h"
 #include "helpers.h"
 
 #include <QInputDialog>
-#include <QTableWidget>
+#include <QTableView>
 #include <QFileDialog>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QPushButton>
+#include <QProgressBar>
 #include <QLabel>
 #include <QMenu>
 
@@ -55,6 +61,11 @@ std::map<std::string, QAction*> createMatrixToolset()
     action_randomize->setText("Randomize...");
     action_randomize->setFont(font);
 
+    QAction* action_view_heatmap = new QAction();
+    action_view_heatmap->setObjectName("action_view_heatmap");
+    action_view_heatmap->setText("View heatmap...");
+    action_view_heatmap->setFont(font);
+
     QAction* action_create_matrix = new QAction();
     action_create_matrix->setObjectName("action_create_matrix");
     action_create_matrix->setText("Create matrix...");
@@ -69,6 +80,7 @@ std::map<std::string, QAction*> createMatrixToolset()
     actions["remove_column"] = action_remove_column;
     actions["randomize"] = action_randomize;
     actions["create_matrix"] = action_create_matrix;
+    actions["view_heatmap"] = action_view_heatmap;
 
     return actions;
 }
@@ -111,17 +123,23 @@ GaussianEliminationTab::GaussianEliminationTab(QWidget *parent)
     labelsLayout->addWidget(label_matrix_B, 2);
     labelsLayout->addWidget(label_vector_x, 2);
 
-    QTableWidget* table_matrix_A = new QTableWidget(layout);
+    modelA = new MatrixTableModel(this);
+    MatrixTableView* table_matrix_A = new MatrixTableView(layout);
     table_matrix_A->setObjectName("table_matrix_A");
     table_matrix_A->setFont(font);
+    table_matrix_A->setModel(modelA);
 
-    QTableWidget* table_matrix_B = new QTableWidget(layout);
+    modelB = new MatrixTableModel(this);
+    MatrixTableView* table_matrix_B = new MatrixTableView(layout);
     table_matrix_B->setObjectName("table_matrix_B");
     table_matrix_B->setFont(font);
+    table_matrix_B->setModel(modelB);
 
-    QTableWidget* table_vector_x = new QTableWidget(layout);
+    modelX = new VectorTableModel(this);
+    MatrixTableView* table_vector_x = new MatrixTableView(layout);
     table_vector_x->setObjectName("table_vector_x");
     table_vector_x->setFont(font);
+    table_vector_x->setModel(modelX);
 
     QHBoxLayout* tablesLayout = new QHBoxLayout();
     tablesLayout->setObjectName("tables_layout");
@@ -153,13 +171,38 @@ GaussianEliminationTab::GaussianEliminationTab(QWidget *parent)
     buttonsLayout->addWidget(button_matrix_B);
     buttonsLayout->addWidget(button_vector_x);
 
+    QProgressBar* progress_bar_solve = new QProgressBar(layout);
+    progress_bar_solve->setObjectName("progress_bar_solve");
+    progress_bar_solve->setFont(font);
+    progress_bar_solve->setVisible(false);
+
+    QPushButton* button_cancel = new QPushButton(layout);
+    button_cancel->setObjectName("button_cancel");
+    button_cancel->setText("Cancel");
+    button_cancel->setFont(font);
+    button_cancel->setVisible(false);
+
+    QHBoxLayout* progressLayout = new QHBoxLayout();
+    progressLayout->setObjectName("progress_layout");
+    progressLayout->addWidget(progress_bar_solve, 1);
+    progressLayout->addWidget(button_cancel);
+
     verticalLayout->addLayout(labelsLayout);
     verticalLayout->addLayout(tablesLayout);
     verticalLayout->addLayout(buttonsLayout);
+    verticalLayout->addLayout(progressLayout);
+
+    worker = new SolverWorker(this);
+    connect(worker, &SolverWorker::progressChanged, this, &GaussianEliminationTab::updateSolveProgress);
+    connect(worker, &SolverWorker::finished, this, &GaussianEliminationTab::finishSolve);
+    connect(worker, &SolverWorker::cancelled, this, &GaussianEliminationTab::stopSolve);
+    connect(worker, &SolverWorker::failed, this, &GaussianEliminationTab::failSolve);
+    connect(button_cancel, &QPushButton::clicked, worker, &SolverWorker::cancel);
 }
 
 GaussianEliminationTab::~GaussianEliminationTab()
 {
+    delete worker;
     delete layout;
 }
 
@@ -171,7 +214,7 @@ void GaussianEliminationTab::loadMatrixA()
 
         if (!filepath.isEmpty())
         {
-            sle->setMatrixA(Matrix::readFromFile(filepath.toStdString()));
+            sle->setMatrixA(MatrixCache::instance().load(filepath.toStdString()));
             updateMatrixA();
         }
     }
@@ -312,9 +355,20 @@ void GaussianEliminationTab::createMatrixA()
     }
 }
 
-void GaussianEliminationTab::setCellA(int rowIndex, int columnIndex)
+void GaussianEliminationTab::viewHeatmapA()
 {
-    sle->getMatrixA().at(rowIndex, columnIndex) = layout->findChild<QTableWidget*>("table_matrix_A")->item(rowIndex, columnIndex)->text().toDouble();
+    try
+    {
+        if (sle->getMatrixA().getNumRows() == 0)
+            throw std::runtime_error("Matrix A is empty");
+
+        std::unique_ptr<HeatmapDialog> dialog = std::make_unique<HeatmapDialog>(sle->getMatrixA(), this);
+        dialog->exec();
+    }
+    catch(const std::exception& ex)
+    {
+        helpers::showError(ex.what());
+    }
 }
 
 void GaussianEliminationTab::loadMatrixB()
@@ -325,7 +379,7 @@ void GaussianEliminationTab::loadMatrixB()
 
         if (!filepath.isEmpty())
         {
-            sle->setMatrixB(Matrix::readFromFile(filepath.toStdString()));
+            sle->setMatrixB(MatrixCache::instance().load(filepath.toStdString()));
             updateMatrixB();
         }
     }
@@ -466,9 +520,20 @@ void GaussianEliminationTab::createMatrixB()
     }
 }
 
-void GaussianEliminationTab::setCellB(int rowIndex, int columnIndex)
+void GaussianEliminationTab::viewHeatmapB()
 {
-    sle->getMatrixB().at(rowIndex, columnIndex) = layout->findChild<QTableWidget*>("table_matrix_B")->item(rowIndex, columnIndex)->text().toDouble();
+    try
+    {
+        if (sle->getMatrixB().getNumRows() == 0)
+            throw std::runtime_error("Matrix B is empty");
+
+        std::unique_ptr<HeatmapDialog> dialog = std::make_unique<HeatmapDialog>(sle->getMatrixB(), this);
+        dialog->exec();
+    }
+    catch(const std::exception& ex)
+    {
+        helpers::showError(ex.what());
+    }
 }
 
 void GaussianEliminationTab::saveVectorX()
@@ -488,52 +553,68 @@ void GaussianEliminationTab::saveVectorX()
 
 void GaussianEliminationTab::updateMatrixA()
 {
-    layout->findChild<QTableWidget*>("table_matrix_A")->setRowCount(sle->getMatrixA().getNumRows());
-    layout->findChild<QTableWidget*>("table_matrix_A")->setColumnCount(sle->getMatrixA().getNumColumns());
-
-    for (size_t i = 0; i < sle->getMatrixA().getNumRows(); ++i)
-    {
-        for (size_t j = 0; j < sle->getMatrixA().getNumColumns(); ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg((sle->getMatrixA().at(i, j))));
-            layout->findChild<QTableWidget*>("table_matrix_A")->setItem(i, j, item);
-        }
-    }
+    modelA->setMatrix(&sle->getMatrixA());
 }
 
 void GaussianEliminationTab::updateMatrixB()
 {
-    layout->findChild<QTableWidget*>("table_matrix_B")->setRowCount(sle->getMatrixB().getNumRows());
-    layout->findChild<QTableWidget*>("table_matrix_B")->setColumnCount(sle->getMatrixB().getNumColumns());
+    modelB->setMatrix(&sle->getMatrixB());
+}
 
-    for (size_t i = 0; i < sle->getMatrixB().getNumRows(); ++i)
+void GaussianEliminationTab::updateVectorX()
+{
+    modelX->setVector(&sle->getVectorX());
+}
+
+void GaussianEliminationTab::solve()
+{
+    try
     {
-        for (size_t j = 0; j < sle->getMatrixB().getNumColumns(); ++j)
+        if (worker->isRunning())
+            return;
+
+        modelX->setVector(nullptr);
+        setSolving(true);
+
+        SLE* system = sle.get();
+        worker->start([system](const CancellationToken& token, const ProgressCallback& progress)
         {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(sle->getMatrixB().at(i, j)));
-            layout->findChild<QTableWidget*>("table_matrix_B")->setItem(i, j, item);
-        }
+            system->solveGaussianElimination(&token, progress);
+        });
+    }
+    catch(const std::exception& ex)
+    {
+        setSolving(false);
+        helpers::showError(ex.what());
     }
 }
 
-void GaussianEliminationTab::updateVectorX()
+void GaussianEliminationTab::updateSolveProgress(int stage, int step, int numSteps, double residual)
 {
-    layout->findChild<QTableWidget*>("table_vector_x")->setRowCount(sle->getVectorX().size());
-    layout->findChild<QTableWidget*>("table_vector_x")->setColumnCount(1);
-
-    for (size_t i = 0; i < sle->getVectorX().size(); ++i)
-    {
-        QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(sle->getVectorX()[i]));
-        layout->findChild<QTableWidget*>("table_vector_x")->setItem(i, 0, item);
+    QProgressBar* progressBar = layout->findChild<QProgressBar*>("progress_bar_solve");
+    progressBar->setRange(0, numSteps);
+    progressBar->setValue(step);
+
+    switch (static_cast<SolverStage>(stage))
+    {
+    case SolverStage::Elimination:
+        progressBar->setFormat(tr("Elimination: pivot %1 of %2").arg(step + 1).arg(numSteps));
+        break;
+    case SolverStage::BackSubstitution:
+        progressBar->setFormat(tr("Back substitution: row %1 of %2").arg(step + 1).arg(numSteps));
+        break;
+    case SolverStage::Iteration:
+        progressBar->setFormat(tr("Iteration %1, residual %2").arg(step).arg(residual, 0, 'g', 3));
+        break;
     }
 }
 
-void GaussianEliminationTab::solve()
+void GaussianEliminationTab::finishSolve()
 {
+    setSolving(false);
+
     try
     {
-        sle->solveGaussianElimination();
-
         updateVectorX();
     }
     catch(const std::exception& ex)
@@ -542,6 +623,32 @@ void GaussianEliminationTab::solve()
     }
 }
 
+void GaussianEliminationTab::stopSolve()
+{
+    setSolving(false);
+}
+
+void GaussianEliminationTab::failSolve(const QString& message)
+{
+    setSolving(false);
+    helpers::showError(message.toStdString());
+}
+
+void GaussianEliminationTab::setSolving(bool solving)
+{
+    layout->findChild<QPushButton*>("button_matrix_A")->setEnabled(!solving);
+    layout->findChild<QPushButton*>("button_matrix_B")->setEnabled(!solving);
+    layout->findChild<QPushButton*>("button_vector_x")->setEnabled(!solving);
+    modelA->setEditable(!solving);
+    modelB->setEditable(!solving);
+
+    QProgressBar* progressBar = layout->findChild<QProgressBar*>("progress_bar_solve");
+    progressBar->setRange(0, 0);
+    progressBar->setFormat(QString());
+    progressBar->setVisible(solving);
+    layout->findChild<QPushButton*>("button_cancel")->setVisible(solving);
+}
+
 void GaussianEliminationTab::createMatrixAMenu()
 {
     auto actions = createMatrixToolset();
@@ -558,6 +665,8 @@ void GaussianEliminationTab::createMatrixAMenu()
     matrixToolset->addSeparator();
     matrixToolset->addAction(actions["randomize"]);
     matrixToolset->addAction(actions["create_matrix"]);
+    matrixToolset->addSeparator();
+    matrixToolset->addAction(actions["view_heatmap"]);
 
     connect(actions["load"], &QAction::triggered, this, &GaussianEliminationTab::loadMatrixA);
     connect(actions["save"], &QAction::triggered, this, &GaussianEliminationTab::saveMatrixA);
@@ -567,7 +676,7 @@ void GaussianEliminationTab::createMatrixAMenu()
     connect(actions["remove_column"], &QAction::triggered, this, &GaussianEliminationTab::removeColumnFromMatrixA);
     connect(actions["randomize"], &QAction::triggered, this, &GaussianEliminationTab::randomizeA);
     connect(actions["create_matrix"], &QAction::triggered, this, &GaussianEliminationTab::createMatrixA);
-    connect(layout->findChild<QTableWidget*>("table_matrix_A"), &QTableWidget::cellChanged, this, &GaussianEliminationTab::setCellA);
+    connect(actions["view_heatmap"], &QAction::triggered, this, &GaussianEliminationTab::viewHeatmapA);
 
     layout->findChild<QPushButton*>("button_matrix_A")->setMenu(matrixToolset);
 }
@@ -588,6 +697,8 @@ void GaussianEliminationTab::createMatrixBMenu()
     matrixToolset->addSeparator();
     matrixToolset->addAction(actions["randomize"]);
     matrixToolset->addAction(actions["create_matrix"]);
+    matrixToolset->addSeparator();
+    matrixToolset->addAction(actions["view_heatmap"]);
 
     connect(actions["load"], &QAction::triggered, this, &GaussianEliminationTab::loadMatrixB);
     connect(actions["save"], &QAction::triggered, this, &GaussianEliminationTab::saveMatrixB);
@@ -597,7 +708,7 @@ void GaussianEliminationTab::createMatrixBMenu()
     connect(actions["remove_column"], &QAction::triggered, this, &GaussianEliminationTab::removeColumnFromMatrixB);
     connect(actions["randomize"], &QAction::triggered, this, &GaussianEliminationTab::randomizeB);
     connect(actions["create_matrix"], &QAction::triggered, this, &GaussianEliminationTab::createMatrixB);
-    connect(layout->findChild<QTableWidget*>("table_matrix_B"), &QTableWidget::cellChanged, this, &GaussianEliminationTab::setCellB);
+    connect(actions["view_heatmap"], &QAction::triggered, this, &GaussianEliminationTab::viewHeatmapB);
 
     layout->findChild<QPushButton*>("button_matrix_B")->setMenu(matrixToolset);
 }
@@ -628,5 +739,6 @@ void GaussianEliminationTab::createVectorXMenu()
 
     layout->findChild<QPushButton*>("button_vector_x")->setMenu(matrixToolset);
 
-    layout->findChild<QTableWidget*>("table_vector_x")->setEditTriggers(QTableWidget::NoEditTriggers);
+    layout->findChild<QTableView*>("table_vector_x")->setEditTriggers(QTableView::NoEditTriggers);
+    modelX->setEditable(false);
 }
@@ -0,0 +1,63 @@
+#include "heatmap_dialog.h"
+
+#include "heatmap_view.h"
+
+#include <QApplication>
+#include <QComboBox>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QTimer>
+#include <QVBoxLayout>
+
+HeatmapDialog::HeatmapDialog(const Matrix& matrix, QWidget *parent)
+    : QDialog(parent)
+{
+    this->setFont(QFont("Arial", 11));
+    this->setWindowTitle(QString("Matrix %1 x %2").arg(matrix.getNumRows()).arg(matrix.getNumRows() ? matrix.getNumColumns() : 0));
+
+    QApplication::setOverrideCursor(Qt::WaitCursor);
+    try
+    {
+        pyramid = std::make_unique<MatrixPyramid>(matrix);
+    }
+    catch (...)
+    {
+        QApplication::restoreOverrideCursor();
+        throw;
+    }
+    QApplication::restoreOverrideCursor();
+
+    QComboBox* modeBox = new QComboBox(this);
+    modeBox->addItem("Max |a|");
+    modeBox->addItem("Mean |a|");
+    modeBox->addItem("Sparsity pattern");
+
+    QPushButton* fitButton = new QPushButton("Fit", this);
+
+    QHBoxLayout* toolsLayout = new QHBoxLayout();
+    toolsLayout->addWidget(modeBox);
+    toolsLayout->addStretch();
+    toolsLayout->addWidget(fitButton);
+
+    view = new HeatmapView(this);
+    view->setPyramid(pyramid.get());
+
+    QLabel* statusLabel = new QLabel(this);
+
+    QVBoxLayout* verticalLayout = new QVBoxLayout(this);
+    verticalLayout->addLayout(toolsLayout);
+    verticalLayout->addWidget(view, 1);
+    verticalLayout->addWidget(statusLabel);
+
+    connect(modeBox, qOverload<int>(&QComboBox::currentIndexChanged), this, &HeatmapDialog::setMode);
+    connect(fitButton, &QPushButton::clicked, view, &HeatmapView::fitToView);
+    connect(view, &HeatmapView::hovered, statusLabel, &QLabel::setText);
+
+    QTimer::singleShot(0, view, &HeatmapView::fitToView);
+}
+
+void HeatmapDialog::setMode(int index)
+{
+    view->setMode(static_cast<HeatmapView::Mode>(index));
+}
@@ -0,0 +1,27 @@
+#ifndef HEATMAPDIALOG_H
+#define HEATMAPDIALOG_H
+
+#include "matrix_pyramid.h"
+
+#include <QDialog>
+
+#include <memory>
+
+class HeatmapView;
+
+class HeatmapDialog : public QDialog
+{
+    Q_OBJECT
+public:
+    HeatmapDialog(const Matrix& matrix, QWidget *parent = nullptr);
+
+private slots:
+    void setMode(int index);
+
+private:
+    std::unique_ptr<MatrixPyramid> pyramid;
+
+    HeatmapView* view;
+};
+
+#endif // HEATMAPDIALOG_H
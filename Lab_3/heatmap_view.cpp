@@ -0,0 +1,281 @@
+#include "heatmap_view.h"
+
+#include <QMouseEvent>
+#include <QPainter>
+#include <QWheelEvent>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace
+{
+constexpr int TILE_SIZE = 256;
+constexpr int MAX_CACHED_TILES = 256;
+constexpr int MIN_ZOOM = -5;
+
+const std::array<QColor, 5> PALETTE = {
+    QColor(68, 1, 84),
+    QColor(59, 82, 139),
+    QColor(33, 145, 140),
+    QColor(94, 201, 98),
+    QColor(253, 231, 37)
+};
+
+QRgb interpolate(double value)
+{
+    value = std::clamp(value, 0.0, 1.0) * (PALETTE.size() - 1);
+    size_t index = std::min(static_cast<size_t>(value), PALETTE.size() - 2);
+    double weight = value - index;
+
+    const QColor& lower = PALETTE[index];
+    const QColor& upper = PALETTE[index + 1];
+    return qRgb(static_cast<int>(lower.red() + weight * (upper.red() - lower.red())),
+                static_cast<int>(lower.green() + weight * (upper.green() - lower.green())),
+                static_cast<int>(lower.blue() + weight * (upper.blue() - lower.blue())));
+}
+
+int getMaxZoom(const MatrixPyramid* pyramid)
+{
+    size_t size = std::max<size_t>(std::max(pyramid->getNumRows(), pyramid->getNumColumns()), 1);
+
+    int zoom = 0;
+    while ((size_t(1) << zoom) < size)
+        ++zoom;
+
+    return zoom;
+}
+}
+
+HeatmapView::HeatmapView(QWidget *parent)
+    : QWidget(parent)
+    , tiles(MAX_CACHED_TILES)
+{
+    setMouseTracking(true);
+    setCursor(Qt::OpenHandCursor);
+}
+
+void HeatmapView::setPyramid(const MatrixPyramid* pyramid)
+{
+    this->pyramid = pyramid;
+    tiles.clear();
+    fitToView();
+}
+
+void HeatmapView::setMode(Mode mode)
+{
+    this->mode = mode;
+    tiles.clear();
+    update();
+}
+
+QSize HeatmapView::sizeHint() const
+{
+    return QSize(600, 600);
+}
+
+void HeatmapView::fitToView()
+{
+    if (pyramid)
+    {
+        double size = static_cast<double>(std::max(pyramid->getNumRows(), pyramid->getNumColumns()));
+        double available = std::max(std::min(width(), height()), 1);
+
+        zoom = MIN_ZOOM;
+        while ((zoom < getMaxZoom(pyramid)) && (size / std::ldexp(1.0, zoom) > available))
+            ++zoom;
+    }
+
+    origin = QPointF();
+    update();
+}
+
+double HeatmapView::getElementsPerPixel() const
+{
+    return std::ldexp(1.0, zoom);
+}
+
+QPointF HeatmapView::toElement(const QPointF& position) const
+{
+    return origin + position * getElementsPerPixel();
+}
+
+void HeatmapView::setZoom(int zoom, const QPointF& anchor)
+{
+    if (!pyramid)
+        return;
+
+    zoom = std::clamp(zoom, MIN_ZOOM, getMaxZoom(pyramid));
+    if (zoom == this->zoom)
+        return;
+
+    QPointF element = toElement(anchor);
+    this->zoom = zoom;
+    origin = element - anchor * getElementsPerPixel();
+    update();
+}
+
+void HeatmapView::paintEvent(QPaintEvent* /*event*/)
+{
+    QPainter painter(this);
+    painter.fillRect(rect(), palette().window());
+
+    if (!pyramid)
+        return;
+
+    double elementsPerPixel = getElementsPerPixel();
+    QPoint originPixel(static_cast<int>(std::floor(origin.x() / elementsPerPixel)),
+                       static_cast<int>(std::floor(origin.y() / elementsPerPixel)));
+
+    int numPixelColumns = static_cast<int>(std::ceil(pyramid->getNumColumns() / elementsPerPixel));
+    int numPixelRows = static_cast<int>(std::ceil(pyramid->getNumRows() / elementsPerPixel));
+
+    int firstTileColumn = std::max(originPixel.x(), 0) / TILE_SIZE;
+    int firstTileRow = std::max(originPixel.y(), 0) / TILE_SIZE;
+    int lastTileColumn = std::min(originPixel.x() + width(), numPixelColumns - 1) / TILE_SIZE;
+    int lastTileRow = std::min(originPixel.y() + height(), numPixelRows - 1) / TILE_SIZE;
+
+    for (int tileRow = firstTileRow; tileRow <= lastTileRow; ++tileRow)
+        for (int tileColumn = firstTileColumn; tileColumn <= lastTileColumn; ++tileColumn)
+            painter.drawImage(QPoint(tileColumn * TILE_SIZE, tileRow * TILE_SIZE) - originPixel, getTile(tileRow, tileColumn));
+
+    painter.setPen(palette().color(QPalette::Text));
+    painter.drawRect(QRect(-originPixel, QSize(numPixelColumns, numPixelRows)));
+}
+
+void HeatmapView::wheelEvent(QWheelEvent* event)
+{
+    int steps = event->angleDelta().y() / 120;
+    if (steps != 0)
+        setZoom(zoom - steps, event->position());
+
+    event->accept();
+}
+
+void HeatmapView::mousePressEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton)
+        return;
+
+    dragging = true;
+    lastMousePosition = event->pos();
+    setCursor(Qt::ClosedHandCursor);
+}
+
+void HeatmapView::mouseMoveEvent(QMouseEvent* event)
+{
+    if (dragging)
+    {
+        origin -= QPointF(event->pos() - lastMousePosition) * getElementsPerPixel();
+        lastMousePosition = event->pos();
+        update();
+    }
+
+    emit hovered(describe(event->pos()));
+}
+
+void HeatmapView::mouseReleaseEvent(QMouseEvent* event)
+{
+    if (event->button() != Qt::LeftButton)
+        return;
+
+    dragging = false;
+    setCursor(Qt::OpenHandCursor);
+}
+
+const QImage& HeatmapView::getTile(int tileRow, int tileColumn)
+{
+    QString key = QString("%1:%2:%3").arg(zoom).arg(tileRow).arg(tileColumn);
+
+    QImage* tile = tiles.object(key);
+    if (!tile)
+    {
+        tile = new QImage(renderTile(tileRow, tileColumn));
+        tiles.insert(key, tile);
+    }
+
+    return *tile;
+}
+
+QImage HeatmapView::renderTile(int tileRow, int tileColumn) const
+{
+    QImage tile(TILE_SIZE, TILE_SIZE, QImage::Format_ARGB32);
+    tile.fill(Qt::transparent);
+
+    size_t blockSize = (zoom > 0) ? (size_t(1) << zoom) : 1;
+    int pixelsPerBlock = (zoom < 0) ? (1 << -zoom) : 1;
+
+    size_t numBlockRows = (pyramid->getNumRows() + blockSize - 1) / blockSize;
+    size_t numBlockColumns = (pyramid->getNumColumns() + blockSize - 1) / blockSize;
+
+    for (int y = 0; y < TILE_SIZE; y += pixelsPerBlock)
+    {
+        size_t blockRow = static_cast<size_t>(tileRow * TILE_SIZE + y) / pixelsPerBlock;
+        if (blockRow >= numBlockRows)
+            break;
+
+        for (int x = 0; x < TILE_SIZE; x += pixelsPerBlock)
+        {
+            size_t blockColumn = static_cast<size_t>(tileColumn * TILE_SIZE + x) / pixelsPerBlock;
+            if (blockColumn >= numBlockColumns)
+                break;
+
+            QRgb color = getColor(pyramid->getBlock(blockSize, blockRow, blockColumn));
+            for (int i = y; i < y + pixelsPerBlock; ++i)
+            {
+                QRgb* line = reinterpret_cast<QRgb*>(tile.scanLine(i));
+                std::fill(line + x, line + x + pixelsPerBlock, color);
+            }
+        }
+    }
+
+    return tile;
+}
+
+QRgb HeatmapView::getColor(const BlockSummary& block) const
+{
+    if (mode == Mode::Sparsity)
+    {
+        if (block.density == 0.0f)
+            return qRgb(255, 255, 255);
+
+        int shade = static_cast<int>(200.0 * (1.0 - std::sqrt(static_cast<double>(block.density))));
+        return qRgb(shade, shade, shade);
+    }
+
+    double maxAbs = pyramid->getMaxAbs();
+    if (maxAbs == 0.0)
+        return interpolate(0.0);
+
+    double value = (mode == Mode::MaxAbs) ? block.maxAbs : block.meanAbs;
+    return interpolate(std::log10(1.0 + 999.0 * value / maxAbs) / 3.0);
+}
+
+QString HeatmapView::describe(const QPointF& position) const
+{
+    if (!pyramid)
+        return QString();
+
+    QPointF element = toElement(position);
+    if ((element.x() < 0.0) || (element.y() < 0.0))
+        return QString();
+
+    size_t blockSize = (zoom > 0) ? (size_t(1) << zoom) : 1;
+    size_t blockRow = static_cast<size_t>(element.y()) / blockSize;
+    size_t blockColumn = static_cast<size_t>(element.x()) / blockSize;
+
+    size_t firstRow = blockRow * blockSize;
+    size_t firstColumn = blockColumn * blockSize;
+    if ((firstRow >= pyramid->getNumRows()) || (firstColumn >= pyramid->getNumColumns()))
+        return QString();
+
+    BlockSummary block = pyramid->getBlock(blockSize, blockRow, blockColumn);
+    if (blockSize == 1)
+        return tr("Row %1, column %2: |a| = %3").arg(firstRow).arg(firstColumn).arg(block.maxAbs);
+
+    size_t lastRow = std::min(firstRow + blockSize, pyramid->getNumRows()) - 1;
+    size_t lastColumn = std::min(firstColumn + blockSize, pyramid->getNumColumns()) - 1;
+    return tr("Rows %1-%2, columns %3-%4: max |a| = %5, mean |a| = %6, nonzeros = %7%")
+        .arg(firstRow).arg(lastRow).arg(firstColumn).arg(lastColumn)
+        .arg(block.maxAbs).arg(block.meanAbs).arg(100.0 * block.density, 0, 'f', 1);
+}
@@ -0,0 +1,63 @@
+#ifndef HEATMAPVIEW_H
+#define HEATMAPVIEW_H
+
+#include "matrix_pyramid.h"
+
+#include <QCache>
+#include <QImage>
+#include <QWidget>
+
+class HeatmapView : public QWidget
+{
+    Q_OBJECT
+
+public:
+    enum class Mode
+    {
+        MaxAbs,
+        MeanAbs,
+        Sparsity
+    };
+
+    explicit HeatmapView(QWidget *parent = nullptr);
+
+    void setPyramid(const MatrixPyramid* pyramid);
+    void setMode(Mode mode);
+
+    QSize sizeHint() const override;
+
+public slots:
+    void fitToView();
+
+signals:
+    void hovered(const QString& description);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void wheelEvent(QWheelEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void mouseMoveEvent(QMouseEvent* event) override;
+    void mouseReleaseEvent(QMouseEvent* event) override;
+
+private:
+    double getElementsPerPixel() const;
+    QPointF toElement(const QPointF& position) const;
+    void setZoom(int zoom, const QPointF& anchor);
+
+    const QImage& getTile(int tileRow, int tileColumn);
+    QImage renderTile(int tileRow, int tileColumn) const;
+    QRgb getColor(const BlockSummary& block) const;
+    QString describe(const QPointF& position) const;
+
+    const MatrixPyramid* pyramid = nullptr;
+    Mode mode = Mode::MaxAbs;
+    int zoom = 0;
+    QPointF origin;
+
+    bool dragging = false;
+    QPoint lastMousePosition;
+
+    QCache<QString, QImage> tiles;
+};
+
+#endif // HEATMAPVIEW_H
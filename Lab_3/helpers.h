@@ -1,11 +0,0 @@
-#ifndef HELPERS_H
-#define HELPERS_H
-
-#include <string>
-
-namespace helpers
-{
-void showError(const std::string& message);
-}
-
-#endif // HELPERS_H
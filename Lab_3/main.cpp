@@ -1,11 +1,16 @@
 #include "mainwindow.h"
 
+#include "thread_pool.h"
+
 #include <QApplication>
 #include <QStyleFactory>
 
+#include <algorithm>
+
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv);
+    ThreadPool::setNumThreads(std::max<size_t>(ThreadPool::getDefaultNumThreads() - 1, 1));
     QApplication::setStyle(QStyleFactory::create("Fusion"));
 
     MainWindow w;
@@ -1,11 +1,15 @@
 #include "matrix_operations_tab.h"
 
+#include "matrix_table_model.h"
+#include "matrix_table_view.h"
 #include "set_matrix_size.h"
+#include "matrix_cache.h"
 #include "randomization.h"
+#include "heatmap_dialog.h"
 #include "helpers.h"
 
 #include <QInputDialog>
-#include <QTableWidget>
+#include <QTableView>
 #include <QFileDialog>
 #include <QGridLayout>
 #include <QPushButton>
@@ -54,6 +58,11 @@ std::map<std::string, QAction*> createMatrixToolset()
     action_randomize->setText("Randomize...");
     action_randomize->setFont(font);
 
+    QAction* action_view_heatmap = new QAction();
+    action_view_heatmap->setObjectName("action_view_heatmap");
+    action_view_heatmap->setText("View heatmap...");
+    action_view_heatmap->setFont(font);
+
     QAction* action_create_matrix = new QAction();
     action_create_matrix->setObjectName("action_create_matrix");
     action_create_matrix->setText("Create matrix...");
@@ -68,6 +77,7 @@ std::map<std::string, QAction*> createMatrixToolset()
     actions["remove_column"] = action_remove_column;
     actions["randomize"] = action_randomize;
     actions["create_matrix"] = action_create_matrix;
+    actions["view_heatmap"] = action_view_heatmap;
 
     return actions;
 }
@@ -103,17 +113,23 @@ MatrixOperationsTab::MatrixOperationsTab(QWidget *parent)
     label_matrix_C->setText("Matrix C:");
     label_matrix_C->setFont(font);
 
-    QTableWidget* table_matrix_A = new QTableWidget(layout);
+    modelA = new MatrixTableModel(this);
+    MatrixTableView* table_matrix_A = new MatrixTableView(layout);
     table_matrix_A->setObjectName("table_matrix_A");
     table_matrix_A->setFont(font);
+    table_matrix_A->setModel(modelA);
 
-    QTableWidget* table_matrix_B = new QTableWidget(layout);
+    modelB = new MatrixTableModel(this);
+    MatrixTableView* table_matrix_B = new MatrixTableView(layout);
     table_matrix_B->setObjectName("table_matrix_B");
     table_matrix_B->setFont(font);
+    table_matrix_B->setModel(modelB);
 
-    QTableWidget* table_matrix_C = new QTableWidget(layout);
+    modelC = new MatrixTableModel(this);
+    MatrixTableView* table_matrix_C = new MatrixTableView(layout);
     table_matrix_C->setObjectName("table_matrix_C");
     table_matrix_C->setFont(font);
+    table_matrix_C->setModel(modelC);
 
     QPushButton* button_matrix_A = new QPushButton(layout);
     button_matrix_A->setObjectName("button_matrix_A");
@@ -157,7 +173,7 @@ void MatrixOperationsTab::loadMatrixA()
 
         if (!filepath.isEmpty())
         {
-            A = std::make_unique<Matrix>(Matrix::readFromFile(filepath.toStdString()));
+            A = std::make_unique<Matrix>(MatrixCache::instance().load(filepath.toStdString()));
             updateMatrixA();
         }
     }
@@ -319,9 +335,23 @@ void MatrixOperationsTab::createMatrixA()
     }
 }
 
-void MatrixOperationsTab::setCellA(int rowIndex, int columnIndex)
+void MatrixOperationsTab::viewHeatmapA()
 {
-    A->at(rowIndex, columnIndex) = layout->findChild<QTableWidget*>("table_matrix_A")->item(rowIndex, columnIndex)->text().toDouble();
+    try
+    {
+        if (!A.get())
+            throw std::runtime_error("Matrix A does not exist");
+
+        if (A->getNumRows() == 0)
+            throw std::runtime_error("Matrix A is empty");
+
+        std::unique_ptr<HeatmapDialog> dialog = std::make_unique<HeatmapDialog>(*A, this);
+        dialog->exec();
+    }
+    catch(const std::exception& ex)
+    {
+        helpers::showError(ex.what());
+    }
 }
 
 void MatrixOperationsTab::loadMatrixB()
@@ -332,7 +362,7 @@ void MatrixOperationsTab::loadMatrixB()
 
         if (!filepath.isEmpty())
         {
-            B = std::make_unique<Matrix>(Matrix::readFromFile(filepath.toStdString()));
+            B = std::make_unique<Matrix>(MatrixCache::instance().load(filepath.toStdString()));
             updateMatrixB();
         }
     }
@@ -495,9 +525,23 @@ void MatrixOperationsTab::createMatrixB()
     }
 }
 
-void MatrixOperationsTab::setCellB(int rowIndex, int columnIndex)
+void MatrixOperationsTab::viewHeatmapB()
 {
-    B->at(rowIndex, columnIndex) = layout->findChild<QTableWidget*>("table_matrix_B")->item(rowIndex, columnIndex)->text().toDouble();
+    try
+    {
+        if (!B.get())
+            throw std::runtime_error("Matrix B does not exist");
+
+        if (B->getNumRows() == 0)
+            throw std::runtime_error("Matrix B is empty");
+
+        std::unique_ptr<HeatmapDialog> dialog = std::make_unique<HeatmapDialog>(*B, this);
+        dialog->exec();
+    }
+    catch(const std::exception& ex)
+    {
+        helpers::showError(ex.what());
+    }
 }
 
 void MatrixOperationsTab::saveMatrixC()
@@ -577,47 +621,17 @@ void MatrixOperationsTab::multiplyMatrices()
 
 void MatrixOperationsTab::updateMatrixA()
 {
-    layout->findChild<QTableWidget*>("table_matrix_A")->setRowCount(A->getNumRows());
-    layout->findChild<QTableWidget*>("table_matrix_A")->setColumnCount(A->getNumColumns());
-
-    for (size_t i = 0; i < A->getNumRows(); ++i)
-    {
-        for (size_t j = 0; j < A->getNumColumns(); ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg((A->at(i, j))));
-            layout->findChild<QTableWidget*>("table_matrix_A")->setItem(i, j, item);
-        }
-    }
+    modelA->setMatrix(A.get());
 }
 
 void MatrixOperationsTab::updateMatrixB()
 {
-    layout->findChild<QTableWidget*>("table_matrix_B")->setRowCount(B->getNumRows());
-    layout->findChild<QTableWidget*>("table_matrix_B")->setColumnCount(B->getNumColumns());
-
-    for (size_t i = 0; i < B->getNumRows(); ++i)
-    {
-        for (size_t j = 0; j < B->getNumColumns(); ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(B->at(i, j)));
-            layout->findChild<QTableWidget*>("table_matrix_B")->setItem(i, j, item);
-        }
-    }
+    modelB->setMatrix(B.get());
 }
 
 void MatrixOperationsTab::updateMatrixC()
 {
-    layout->findChild<QTableWidget*>("table_matrix_C")->setRowCount(C->getNumRows());
-    layout->findChild<QTableWidget*>("table_matrix_C")->setColumnCount(C->getNumColumns());
-
-    for (size_t i = 0; i < C->getNumRows(); ++i)
-    {
-        for (size_t j = 0; j < C->getNumColumns(); ++j)
-        {
-            QTableWidgetItem* item = new QTableWidgetItem(tr("%1").arg(C->at(i, j)));
-            layout->findChild<QTableWidget*>("table_matrix_C")->setItem(i, j, item);
-        }
-    }
+    modelC->setMatrix(C.get());
 }
 
 void MatrixOperationsTab::createMatrixAMenu()
@@ -636,6 +650,8 @@ void MatrixOperationsTab::createMatrixAMenu()
     matrixToolset->addSeparator();
     matrixToolset->addAction(actions["randomize"]);
     matrixToolset->addAction(actions["create_matrix"]);
+    matrixToolset->addSeparator();
+    matrixToolset->addAction(actions["view_heatmap"]);
 
     connect(actions["load"], &QAction::triggered, this, &MatrixOperationsTab::loadMatrixA);
     connect(actions["save"], &QAction::triggered, this, &MatrixOperationsTab::saveMatrixA);
@@ -645,7 +661,7 @@ void MatrixOperationsTab::createMatrixAMenu()
     connect(actions["remove_column"], &QAction::triggered, this, &MatrixOperationsTab::removeColumnFromMatrixA);
     connect(actions["randomize"], &QAction::triggered, this, &MatrixOperationsTab::randomizeA);
     connect(actions["create_matrix"], &QAction::triggered, this, &MatrixOperationsTab::createMatrixA);
-    connect(layout->findChild<QTableWidget*>("table_matrix_A"), &QTableWidget::cellChanged, this, &MatrixOperationsTab::setCellA);
+    connect(actions["view_heatmap"], &QAction::triggered, this, &MatrixOperationsTab::viewHeatmapA);
 
     layout->findChild<QPushButton*>("button_matrix_A")->setMenu(matrixToolset);
 }
@@ -666,6 +682,8 @@ void MatrixOperationsTab::createMatrixBMenu()
     matrixToolset->addSeparator();
     matrixToolset->addAction(actions["randomize"]);
     matrixToolset->addAction(actions["create_matrix"]);
+    matrixToolset->addSeparator();
+    matrixToolset->addAction(actions["view_heatmap"]);
 
     connect(actions["load"], &QAction::triggered, this, &MatrixOperationsTab::loadMatrixB);
     connect(actions["save"], &QAction::triggered, this, &MatrixOperationsTab::saveMatrixB);
@@ -675,7 +693,7 @@ void MatrixOperationsTab::createMatrixBMenu()
     connect(actions["remove_column"], &QAction::triggered, this, &MatrixOperationsTab::removeColumnFromMatrixB);
     connect(actions["randomize"], &QAction::triggered, this, &MatrixOperationsTab::randomizeB);
     connect(actions["create_matrix"], &QAction::triggered, this, &MatrixOperationsTab::createMatrixB);
-    connect(layout->findChild<QTableWidget*>("table_matrix_B"), &QTableWidget::cellChanged, this, &MatrixOperationsTab::setCellB);
+    connect(actions["view_heatmap"], &QAction::triggered, this, &MatrixOperationsTab::viewHeatmapB);
 
     layout->findChild<QPushButton*>("button_matrix_B")->setMenu(matrixToolset);
 }
@@ -720,5 +738,6 @@ void MatrixOperationsTab::createMatrixCMenu()
 
     layout->findChild<QPushButton*>("button_matrix_C")->setMenu(matrixToolset);
 
-    layout->findChild<QTableWidget*>("table_matrix_C")->setEditTriggers(QTableWidget::NoEditTriggers);
+    layout->findChild<QTableView*>("table_matrix_C")->setEditTriggers(QTableView::NoEditTriggers);
+    modelC->setEditable(false);
 }
@@ -7,6 +7,8 @@
 
 #include <memory>
 
+class MatrixTableModel;
+
 class MatrixOperationsTab : public QWidget
 {
     Q_OBJECT
@@ -24,7 +26,7 @@ private slots:
     void removeColumnFromMatrixA();
     void randomizeA();
     void createMatrixA();
-    void setCellA(int rowIndex, int columnIndex);
+    void viewHeatmapA();
 
     void loadMatrixB();
     void saveMatrixB();
@@ -34,7 +36,7 @@ private slots:
     void removeColumnFromMatrixB();
     void randomizeB();
     void createMatrixB();
-    void setCellB(int rowIndex, int columnIndex);
+    void viewHeatmapB();
 
     void saveMatrixC();
     void addMatrices();
@@ -52,6 +54,9 @@ private:
 
 private:
     QWidget* layout;
+    MatrixTableModel* modelA;
+    MatrixTableModel* modelB;
+    MatrixTableModel* modelC;
 
     std::unique_ptr<Matrix> A;
     std::unique_ptr<Matrix> B;
@@ -0,0 +1,80 @@
+#include "solver_worker.h"
+
+#include <chrono>
+
+namespace
+{
+constexpr std::chrono::milliseconds PROGRESS_INTERVAL(50);
+}
+
+SolverWorker::SolverWorker(QObject *parent)
+    : QObject(parent)
+{
+}
+
+SolverWorker::~SolverWorker()
+{
+    cancel();
+
+    if (thread)
+        thread->wait();
+}
+
+bool SolverWorker::isRunning() const
+{
+    return thread && thread->isRunning();
+}
+
+void SolverWorker::setTelemetry(std::shared_ptr<Telemetry> telemetry)
+{
+    this->telemetry = std::move(telemetry);
+}
+
+void SolverWorker::start(Job job)
+{
+    if (isRunning())
+        throw std::runtime_error("The solver is already running");
+
+    token = std::make_shared<CancellationToken>();
+
+    thread = QThread::create([this, job = std::move(job), token = token, telemetry = telemetry]()
+    {
+        auto lastReport = std::chrono::steady_clock::time_point();
+
+        ProgressCallback progress = [this, &lastReport, &telemetry](const SolverProgress& state)
+        {
+            if (telemetry)
+                telemetry->push(state);
+
+            auto now = std::chrono::steady_clock::now();
+            if ((now - lastReport < PROGRESS_INTERVAL) && (state.step + 1 < state.numSteps))
+                return;
+
+            lastReport = now;
+            emit progressChanged(static_cast<int>(state.stage), static_cast<int>(state.step), static_cast<int>(state.numSteps), state.residual);
+        };
+
+        try
+        {
+            job(*token, progress);
+            emit finished();
+        }
+        catch (const SolveCancelled&)
+        {
+            emit cancelled();
+        }
+        catch (const std::exception& ex)
+        {
+            emit failed(QString::fromUtf8(ex.what()));
+        }
+    });
+
+    connect(thread, &QThread::finished, thread, &QObject::deleteLater);
+    thread->start();
+}
+
+void SolverWorker::cancel()
+{
+    if (token)
+        token->cancel();
+}
@@ -0,0 +1,45 @@
+#ifndef SOLVERWORKER_H
+#define SOLVERWORKER_H
+
+#include "sle.h"
+#include "ring_buffer.h"
+
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QThread>
+
+#include <functional>
+#include <memory>
+
+class SolverWorker : public QObject
+{
+    Q_OBJECT
+
+public:
+    using Job = std::function<void(const CancellationToken&, const ProgressCallback&)>;
+    using Telemetry = RingBuffer<SolverProgress>;
+
+    explicit SolverWorker(QObject *parent = nullptr);
+    ~SolverWorker();
+
+    bool isRunning() const;
+    void setTelemetry(std::shared_ptr<Telemetry> telemetry);
+    void start(Job job);
+
+public slots:
+    void cancel();
+
+signals:
+    void progressChanged(int stage, int step, int numSteps, double residual);
+    void finished();
+    void cancelled();
+    void failed(const QString& message);
+
+private:
+    QPointer<QThread> thread;
+    std::shared_ptr<CancellationToken> token;
+    std::shared_ptr<Telemetry> telemetry;
+};
+
+#endif // SOLVERWORKER_H
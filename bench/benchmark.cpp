@@ -0,0 +1,574 @@
+#include "benchmark.h"
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <iomanip>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#ifndef BENCHMARK_BUILD_TYPE
+#define BENCHMARK_BUILD_TYPE ""
+#endif
+
+namespace
+{
+volatile double sink = 0.0;
+
+void writeString(std::ostream& output, const std::string& value)
+{
+    output << '"';
+    for (char symbol : value)
+    {
+        if ((symbol == '"') || (symbol == '\\'))
+            output << '\\';
+        output << symbol;
+    }
+    output << '"';
+}
+
+std::string getCompilerName()
+{
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc " + std::to_string(_MSC_VER);
+#else
+    return "unknown";
+#endif
+}
+
+std::string getTimestamp()
+{
+    std::time_t now = std::time(nullptr);
+    char buffer[32];
+    std::strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    return buffer;
+}
+
+bool isSelected(const std::string& filter, const std::string& name)
+{
+    if (filter.empty())
+        return true;
+
+    std::istringstream input(filter);
+    for (std::string item; std::getline(input, item, ',');)
+        if (!item.empty() && (name.find(item) != std::string::npos))
+            return true;
+
+    return false;
+}
+
+BenchmarkResult* findResult(std::vector<BenchmarkResult>& results, const std::string& name, MatrixClass matrixClass, size_t size)
+{
+    for (BenchmarkResult& result : results)
+        if ((result.name == name) && (result.matrixClass == matrixClass) && (result.size == size))
+            return &result;
+
+    return nullptr;
+}
+
+double getMedianOf(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+
+    size_t middle = values.size() / 2;
+    return (values.size() % 2) ? values[middle] : (values[middle - 1] + values[middle]) / 2.0;
+}
+
+struct JsonValue
+{
+    enum class Type
+    {
+        Null,
+        Boolean,
+        Number,
+        String,
+        Array,
+        Object
+    };
+
+    const JsonValue& at(const std::string& key) const
+    {
+        for (const auto& [name, value] : members)
+            if (name == key)
+                return value;
+
+        throw std::runtime_error("Missing JSON key: " + key);
+    }
+
+    const JsonValue* find(const std::string& key) const
+    {
+        for (const auto& [name, value] : members)
+            if (name == key)
+                return &value;
+
+        return nullptr;
+    }
+
+    Type type = Type::Null;
+    double number = 0.0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+};
+
+class JsonParser
+{
+public:
+    explicit JsonParser(std::string text)
+        : text(std::move(text))
+    {
+    }
+
+    JsonValue parse()
+    {
+        JsonValue value = parseValue();
+        skipWhitespace();
+        if (position != text.size())
+            fail();
+
+        return value;
+    }
+
+private:
+    JsonValue parseValue()
+    {
+        skipWhitespace();
+        if (position >= text.size())
+            fail();
+
+        JsonValue value;
+        char symbol = text[position];
+
+        if (symbol == '{')
+        {
+            value.type = JsonValue::Type::Object;
+            ++position;
+            if (!consume('}'))
+            {
+                do
+                {
+                    skipWhitespace();
+                    std::string key = parseString();
+                    if (!consume(':'))
+                        fail();
+                    value.members.emplace_back(std::move(key), parseValue());
+                } while (consume(','));
+
+                if (!consume('}'))
+                    fail();
+            }
+        }
+        else if (symbol == '[')
+        {
+            value.type = JsonValue::Type::Array;
+            ++position;
+            if (!consume(']'))
+            {
+                do
+                    value.items.push_back(parseValue());
+                while (consume(','));
+
+                if (!consume(']'))
+                    fail();
+            }
+        }
+        else if (symbol == '"')
+        {
+            value.type = JsonValue::Type::String;
+            value.text = parseString();
+        }
+        else if (text.compare(position, 4, "true") == 0 || text.compare(position, 5, "false") == 0)
+        {
+            value.type = JsonValue::Type::Boolean;
+            value.number = (symbol == 't') ? 1.0 : 0.0;
+            position += (symbol == 't') ? 4 : 5;
+        }
+        else if (text.compare(position, 4, "null") == 0)
+        {
+            position += 4;
+        }
+        else
+        {
+            const char* begin = text.c_str() + position;
+            char* end = nullptr;
+            value.type = JsonValue::Type::Number;
+            value.number = std::strtod(begin, &end);
+            if (end == begin)
+                fail();
+            position += static_cast<size_t>(end - begin);
+        }
+
+        return value;
+    }
+
+    std::string parseString()
+    {
+        if ((position >= text.size()) || (text[position] != '"'))
+            fail();
+        ++position;
+
+        std::string result;
+        while ((position < text.size()) && (text[position] != '"'))
+        {
+            if (text[position] == '\\')
+                ++position;
+            if (position < text.size())
+                result += text[position++];
+        }
+
+        if (position >= text.size())
+            fail();
+        ++position;
+
+        return result;
+    }
+
+    bool consume(char symbol)
+    {
+        skipWhitespace();
+        if ((position < text.size()) && (text[position] == symbol))
+        {
+            ++position;
+            return true;
+        }
+
+        return false;
+    }
+
+    void skipWhitespace()
+    {
+        while ((position < text.size()) && std::isspace(static_cast<unsigned char>(text[position])))
+            ++position;
+    }
+
+    [[noreturn]] void fail() const
+    {
+        throw std::runtime_error("Malformed benchmark JSON at offset " + std::to_string(position));
+    }
+
+    std::string text;
+    size_t position = 0;
+};
+}
+
+double BenchmarkResult::getMin() const
+{
+    return *std::min_element(samples.begin(), samples.end());
+}
+
+double BenchmarkResult::getMax() const
+{
+    return *std::max_element(samples.begin(), samples.end());
+}
+
+double BenchmarkResult::getMean() const
+{
+    return std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size();
+}
+
+double BenchmarkResult::getMedian() const
+{
+    return getMedianOf(samples);
+}
+
+double BenchmarkResult::getMedianAbsoluteDeviation() const
+{
+    double median = getMedian();
+
+    std::vector<double> deviations;
+    deviations.reserve(samples.size());
+    for (double sample : samples)
+        deviations.push_back(std::abs(sample - median));
+
+    return getMedianOf(std::move(deviations));
+}
+
+double BenchmarkResult::getStandardDeviation() const
+{
+    if (samples.size() < 2)
+        return 0.0;
+
+    double mean = getMean();
+    double sum = 0.0;
+    for (double sample : samples)
+        sum += (sample - mean) * (sample - mean);
+
+    return std::sqrt(sum / (samples.size() - 1));
+}
+
+double BenchmarkResult::getValue() const
+{
+    return (metric == Metric::Seconds) ? getMedian() : work / getMedian();
+}
+
+BenchmarkSuite::BenchmarkSuite(const BenchmarkSettings& settings)
+    : settings(settings)
+{
+    if (settings.repetitions == 0)
+        throw std::invalid_argument("The number of repetitions should be positive");
+    if (settings.runs == 0)
+        throw std::invalid_argument("The number of runs should be positive");
+}
+
+void BenchmarkSuite::add(const std::string& name, Factory factory, Predicate predicate /*= nullptr*/, Metric metric /*= Metric::Seconds*/, Work work /*= nullptr*/)
+{
+    if ((metric != Metric::Seconds) && !work)
+        throw std::invalid_argument("Throughput benchmarks need the amount of work per run");
+
+    benchmarks.push_back({ name, std::move(factory), std::move(predicate), metric, std::move(work) });
+}
+
+std::vector<BenchmarkResult> BenchmarkSuite::run(std::ostream* log /*= nullptr*/)
+{
+    std::vector<BenchmarkResult> results;
+
+    for (size_t round = 0; round < settings.runs; ++round)
+    {
+        for (MatrixClass matrixClass : settings.classes)
+        {
+            for (size_t size : settings.sizes)
+            {
+                Fixture fixture = createFixture(matrixClass, size);
+
+                for (const Benchmark& benchmark : benchmarks)
+                {
+                    if (!isSelected(settings.filter, benchmark.name))
+                        continue;
+                    if (benchmark.predicate && !benchmark.predicate(matrixClass))
+                        continue;
+
+                    std::vector<double> samples;
+                    double work = 1.0;
+
+                    try
+                    {
+                        Body body = benchmark.factory(fixture);
+
+                        for (size_t index = 0; index < settings.warmup; ++index)
+                            sink = sink + body();
+
+                        for (size_t index = 0; index < settings.repetitions; ++index)
+                        {
+                            auto start = std::chrono::steady_clock::now();
+                            sink = sink + body();
+                            samples.push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+                        }
+
+                        if (benchmark.work)
+                            work = benchmark.work(fixture);
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        if (log)
+                            *log << benchmark.name << '/' << getClassName(matrixClass) << '/' << size << ": skipped, " << ex.what() << std::endl;
+                        continue;
+                    }
+
+                    BenchmarkResult* result = findResult(results, benchmark.name, matrixClass, size);
+                    if (!result)
+                    {
+                        results.push_back({ benchmark.name, matrixClass, size, {}, benchmark.metric });
+                        result = &results.back();
+                    }
+
+                    result->samples.insert(result->samples.end(), samples.begin(), samples.end());
+                    result->work = work;
+
+                    if (log && (round + 1 == settings.runs))
+                    {
+                        *log << std::left << std::setw(28) << result->name << std::setw(22) << getClassName(matrixClass) << std::right << std::setw(6) << size
+                             << std::scientific << std::setprecision(3)
+                             << "  median " << result->getMedian() << " s"
+                             << "  min " << result->getMin() << " s"
+                             << "  stddev " << result->getStandardDeviation() << " s";
+                        if (result->metric != Metric::Seconds)
+                            *log << std::fixed << std::setprecision(2) << "  " << result->getValue() << ' ' << getMetricName(result->metric);
+                        *log << std::defaultfloat << std::endl;
+                    }
+                }
+
+                std::error_code error;
+                std::filesystem::remove_all(fixture.directory, error);
+            }
+        }
+    }
+
+    return results;
+}
+
+void BenchmarkSuite::writeJson(const BenchmarkSettings& settings, const std::vector<BenchmarkResult>& results, std::ostream& output)
+{
+    output << std::setprecision(9);
+    output << "{\n";
+    output << "  \"context\": {\n";
+    output << "    \"timestamp\": "; writeString(output, getTimestamp()); output << ",\n";
+    output << "    \"compiler\": "; writeString(output, getCompilerName()); output << ",\n";
+    output << "    \"build_type\": "; writeString(output, BENCHMARK_BUILD_TYPE); output << ",\n";
+    output << "    \"hardware_concurrency\": " << std::thread::hardware_concurrency() << ",\n";
+    output << "    \"threads\": " << ThreadPool::getInstance().getNumThreads() << ",\n";
+    output << "    \"warmup\": " << settings.warmup << ",\n";
+    output << "    \"repetitions\": " << settings.repetitions << ",\n";
+    output << "    \"runs\": " << settings.runs << ",\n";
+    output << "    \"seed\": " << settings.seed << "\n";
+    output << "  },\n";
+    output << "  \"benchmarks\": [";
+
+    for (size_t index = 0; index < results.size(); ++index)
+    {
+        const BenchmarkResult& result = results[index];
+
+        output << (index ? ",\n" : "\n") << "    {\n";
+        output << "      \"name\": "; writeString(output, result.name); output << ",\n";
+        output << "      \"class\": "; writeString(output, getClassName(result.matrixClass)); output << ",\n";
+        output << "      \"size\": " << result.size << ",\n";
+        output << "      \"min_seconds\": " << result.getMin() << ",\n";
+        output << "      \"median_seconds\": " << result.getMedian() << ",\n";
+        output << "      \"mean_seconds\": " << result.getMean() << ",\n";
+        output << "      \"max_seconds\": " << result.getMax() << ",\n";
+        output << "      \"stddev_seconds\": " << result.getStandardDeviation() << ",\n";
+        output << "      \"mad_seconds\": " << result.getMedianAbsoluteDeviation() << ",\n";
+        output << "      \"metric\": "; writeString(output, getMetricName(result.metric)); output << ",\n";
+        output << "      \"work\": " << result.work << ",\n";
+        output << "      \"value\": " << result.getValue() << ",\n";
+        output << "      \"samples\": [";
+        for (size_t sample = 0; sample < result.samples.size(); ++sample)
+            output << (sample ? ", " : "") << result.samples[sample];
+        output << "]\n";
+        output << "    }";
+    }
+
+    output << (results.empty() ? "]\n" : "\n  ]\n");
+    output << "}\n";
+}
+
+std::vector<BenchmarkResult> BenchmarkSuite::readJson(std::istream& input)
+{
+    JsonValue root = JsonParser(std::string(std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>())).parse();
+
+    std::vector<BenchmarkResult> results;
+    for (const JsonValue& entry : root.at("benchmarks").items)
+    {
+        BenchmarkResult result{ entry.at("name").text, parseClassName(entry.at("class").text), static_cast<size_t>(entry.at("size").number), {} };
+        for (const JsonValue& sample : entry.at("samples").items)
+            result.samples.push_back(sample.number);
+
+        if (const JsonValue* metric = entry.find("metric"))
+            result.metric = parseMetricName(metric->text);
+        if (const JsonValue* work = entry.find("work"))
+            result.work = work->number;
+
+        if (result.samples.empty())
+            throw std::runtime_error("Benchmark " + result.name + " has no samples");
+
+        results.push_back(std::move(result));
+    }
+
+    return results;
+}
+
+const char* BenchmarkSuite::getClassName(MatrixClass matrixClass)
+{
+    switch (matrixClass)
+    {
+    case MatrixClass::Random:
+        return "random";
+    case MatrixClass::DiagonallyDominant:
+        return "diagonally_dominant";
+    case MatrixClass::SymmetricPositiveDefinite:
+        return "spd";
+    }
+
+    return "";
+}
+
+MatrixClass BenchmarkSuite::parseClassName(const std::string& name)
+{
+    for (MatrixClass matrixClass : { MatrixClass::Random, MatrixClass::DiagonallyDominant, MatrixClass::SymmetricPositiveDefinite })
+        if (name == getClassName(matrixClass))
+            return matrixClass;
+
+    throw std::invalid_argument("Unknown matrix class: " + name);
+}
+
+const char* BenchmarkSuite::getMetricName(Metric metric)
+{
+    switch (metric)
+    {
+    case Metric::Seconds:
+        return "s";
+    case Metric::GigaflopsPerSecond:
+        return "GFLOP/s";
+    case Metric::MegabytesPerSecond:
+        return "MB/s";
+    }
+
+    return "";
+}
+
+Metric BenchmarkSuite::parseMetricName(const std::string& name)
+{
+    for (Metric metric : { Metric::Seconds, Metric::GigaflopsPerSecond, Metric::MegabytesPerSecond })
+        if (name == getMetricName(metric))
+            return metric;
+
+    throw std::invalid_argument("Unknown metric: " + name);
+}
+
+Fixture BenchmarkSuite::createFixture(MatrixClass matrixClass, size_t size) const
+{
+    std::mt19937_64 generator(settings.seed + size * 31 + static_cast<size_t>(matrixClass));
+    std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+    int n = static_cast<int>(size);
+    Fixture fixture{ matrixClass, size, Matrix(n, n), Matrix(n, 1), {} };
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        fixture.B[i][0] = distribution(generator);
+        for (size_t j = 0; j < size; ++j)
+            fixture.A[i][j] = distribution(generator);
+    }
+
+    if (matrixClass == MatrixClass::DiagonallyDominant)
+    {
+        for (size_t i = 0; i < size; ++i)
+            fixture.A[i][i] += (fixture.A[i][i] < 0.0) ? -static_cast<double>(size) : static_cast<double>(size);
+    }
+    else if (matrixClass == MatrixClass::SymmetricPositiveDefinite)
+    {
+        Matrix M = fixture.A;
+        for (size_t i = 0; i < size; ++i)
+        {
+            for (size_t j = 0; j <= i; ++j)
+            {
+                double sum = 0.0;
+                for (size_t k = 0; k < size; ++k)
+                    sum += M[i][k] * M[j][k];
+
+                fixture.A[i][j] = sum / size + ((i == j) ? 1.0 : 0.0);
+                fixture.A[j][i] = fixture.A[i][j];
+            }
+        }
+    }
+
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / ("linear_algebra_benchmarks_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    std::filesystem::create_directories(directory);
+    fixture.directory = directory.string();
+
+    return fixture;
+}
@@ -0,0 +1,102 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "matrix.h"
+
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum class MatrixClass
+{
+    Random,
+    DiagonallyDominant,
+    SymmetricPositiveDefinite
+};
+
+enum class Metric
+{
+    Seconds,
+    GigaflopsPerSecond,
+    MegabytesPerSecond
+};
+
+struct Fixture
+{
+    MatrixClass matrixClass;
+    size_t size;
+    Matrix A;
+    Matrix B;
+    std::string directory;
+};
+
+struct BenchmarkSettings
+{
+    std::vector<size_t> sizes = { 64, 128, 256 };
+    std::vector<MatrixClass> classes = { MatrixClass::Random, MatrixClass::DiagonallyDominant, MatrixClass::SymmetricPositiveDefinite };
+    size_t warmup = 1;
+    size_t repetitions = 5;
+    size_t runs = 1;
+    size_t numThreads = 0;
+    std::string filter;
+    unsigned seed = 42;
+};
+
+struct BenchmarkResult
+{
+    std::string name;
+    MatrixClass matrixClass;
+    size_t size;
+    std::vector<double> samples;
+    Metric metric = Metric::Seconds;
+    double work = 1.0;
+
+    double getMin() const;
+    double getMax() const;
+    double getMean() const;
+    double getMedian() const;
+    double getMedianAbsoluteDeviation() const;
+    double getStandardDeviation() const;
+    double getValue() const;
+};
+
+class BenchmarkSuite
+{
+public:
+    using Body = std::function<double()>;
+    using Factory = std::function<Body(Fixture& fixture)>;
+    using Predicate = std::function<bool(MatrixClass matrixClass)>;
+    using Work = std::function<double(const Fixture& fixture)>;
+
+    explicit BenchmarkSuite(const BenchmarkSettings& settings);
+
+    void add(const std::string& name, Factory factory, Predicate predicate = nullptr, Metric metric = Metric::Seconds, Work work = nullptr);
+    std::vector<BenchmarkResult> run(std::ostream* log = nullptr);
+
+    static void writeJson(const BenchmarkSettings& settings, const std::vector<BenchmarkResult>& results, std::ostream& output);
+    static std::vector<BenchmarkResult> readJson(std::istream& input);
+
+    static const char* getClassName(MatrixClass matrixClass);
+    static MatrixClass parseClassName(const std::string& name);
+    static const char* getMetricName(Metric metric);
+    static Metric parseMetricName(const std::string& name);
+
+private:
+    struct Benchmark
+    {
+        std::string name;
+        Factory factory;
+        Predicate predicate;
+        Metric metric;
+        Work work;
+    };
+
+    Fixture createFixture(MatrixClass matrixClass, size_t size) const;
+
+    BenchmarkSettings settings;
+    std::vector<Benchmark> benchmarks;
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,367 @@
+#include "benchmark.h"
+#include "regression.h"
+
+#include "matrix.h"
+#include "vector.h"
+#include "sle.h"
+#include "block_factorization.h"
+#include "reduction.h"
+#include "thread_pool.h"
+
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+namespace
+{
+constexpr const char* USAGE =
+    "Usage: linear_algebra_benchmarks [options]\n"
+    "\n"
+    "Options:\n"
+    "      --sizes <list>          comma-separated matrix sizes (default: 64,128,256)\n"
+    "      --classes <list>        random, diagonally_dominant, spd (default: all)\n"
+    "      --warmup <n>            untimed runs before measuring (default: 1)\n"
+    "      --repetitions <n>       timed runs per benchmark (default: 5)\n"
+    "      --runs <n>              passes over the whole suite, pooled into one sample set (default: 1)\n"
+    "      --filter <list>         run only benchmarks whose name contains one of the comma-separated texts\n"
+    "      --seed <n>              seed for the generated matrices (default: 42)\n"
+    "  -t, --threads <n>           threads used by the kernels (default: all cores)\n"
+    "  -o, --output <file>         write JSON to a file instead of stdout\n"
+    "      --baseline <file>       compare against a stored run, exit with 3 on a regression\n"
+    "      --threshold <percent>   slowdown tolerated before a benchmark regresses (default: 10)\n"
+    "  -h, --help                  show this message\n";
+
+std::vector<std::string> split(const std::string& text)
+{
+    std::vector<std::string> items;
+    std::istringstream input(text);
+    for (std::string item; std::getline(input, item, ',');)
+        if (!item.empty())
+            items.push_back(item);
+
+    return items;
+}
+
+size_t parseCount(const std::string& option, const std::string& text)
+{
+    std::istringstream input(text);
+    long long value;
+    if (!(input >> value) || !input.eof() || (value < 0))
+        throw std::invalid_argument("Invalid value for " + option + ": " + text);
+
+    return static_cast<size_t>(value);
+}
+
+Vector getColumn(const Matrix& matrix)
+{
+    Vector column(static_cast<int>(matrix.getNumRows()));
+    for (size_t i = 0; i < matrix.getNumRows(); ++i)
+        column[i] = matrix[i][0];
+
+    return column;
+}
+
+Matrix createOther(const Fixture& fixture)
+{
+    Matrix other = fixture.A;
+    other.randomize(-1.0, 1.0);
+    return other;
+}
+
+double getGigaflops(const Fixture& fixture, double scale)
+{
+    double n = static_cast<double>(fixture.size);
+    return scale * n * n * n / 1e9;
+}
+
+double getMegabytes(const std::string& filepath)
+{
+    return static_cast<double>(std::filesystem::file_size(filepath)) / 1e6;
+}
+
+SolverOptions getSolverOptions()
+{
+    SolverOptions options;
+    options.reportPath.clear();
+    return options;
+}
+
+double calculateReproducibly(const std::function<double()>& body)
+{
+    setReductionMode(ReductionMode::Reproducible);
+    double result = body();
+    setReductionMode(ReductionMode::Fast);
+    return result;
+}
+
+void registerBenchmarks(BenchmarkSuite& suite)
+{
+    suite.add("matrix_add", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [&A = fixture.A, other = createOther(fixture)]() { return Matrix(A + other)[0][0]; };
+    });
+
+    suite.add("matrix_subtract", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [&A = fixture.A, other = createOther(fixture)]() { return Matrix(A - other)[0][0]; };
+    });
+
+    suite.add("matrix_fused_expression", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [&A = fixture.A, other = createOther(fixture), result = Matrix()]() mutable
+        {
+            result = A + other - A * 0.5;
+            return result[0][0];
+        };
+    });
+
+    suite.add("matrix_add_scaled", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [&A = fixture.A, result = createOther(fixture)]() mutable
+        {
+            result.addScaled(A, 1e-3);
+            return result[0][0];
+        };
+    });
+
+    suite.add("matrix_multiply", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [&A = fixture.A, other = createOther(fixture)]() { return (A * other)[0][0]; };
+    }, nullptr, Metric::GigaflopsPerSecond, [](const Fixture& fixture) { return getGigaflops(fixture, 2.0); });
+
+    suite.add("matrix_norm", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [&A = fixture.A]() { return A.calculateEuclidianNorm(); };
+    });
+
+    suite.add("matrix_norm_reproducible", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [&A = fixture.A]() { return calculateReproducibly([&A]() { return A.calculateEuclidianNorm(); }); };
+    });
+
+    suite.add("vector_add", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [b = getColumn(fixture.B)]() { return Vector(b + b)[0]; };
+    });
+
+    suite.add("vector_subtract", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [b = getColumn(fixture.B)]() { return Vector(b - b)[0]; };
+    });
+
+    suite.add("vector_scale", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [b = getColumn(fixture.B)]() { return Vector(b * 2.0)[0]; };
+    });
+
+    suite.add("vector_norm", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [b = getColumn(fixture.B)]() { return b.calculateEuclidianNorm(); };
+    });
+
+    suite.add("vector_norm_reproducible", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [b = getColumn(fixture.B)]() { return calculateReproducibly([&b]() { return b.calculateEuclidianNorm(); }); };
+    });
+
+    suite.add("lu_decomposition", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [&A = fixture.A]()
+        {
+            Matrix lower, upper;
+            A.caclulateLUDecomposition(lower, upper);
+            return upper[upper.getNumRows() - 1][upper.getNumColumns() - 1];
+        };
+    }, nullptr, Metric::GigaflopsPerSecond, [](const Fixture& fixture) { return getGigaflops(fixture, 2.0 / 3.0); });
+
+    suite.add("inverse", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        return [&A = fixture.A]() { return A.calculateInverse()[0][0]; };
+    });
+
+    suite.add("solve_gaussian_elimination", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        auto sle = std::make_shared<SLE>();
+        sle->setOptions(getSolverOptions());
+        sle->setMatrixA(fixture.A);
+        sle->setMatrixB(fixture.B);
+
+        return [sle]()
+        {
+            sle->solveGaussianElimination();
+            return sle->getVectorX()[0];
+        };
+    });
+
+    suite.add("solve_gauss_seidel", [](Fixture& fixture) -> BenchmarkSuite::Body
+    {
+        auto sle = std::make_shared<SLE>();
+        sle->setOptions(getSolverOptions());
+        sle->setMatrixA(fixture.A);
+        sle->setMatrixB(fixture.B);
+
+        return [sle]()
+        {
+            sle->solveGaussSeidelMethod();
+            return sle->getVectorX()[0];
+        };
+    }, [](MatrixClass matrixClass) { return matrixClass != MatrixClass::Random; });
+
+    for (TaskScheduling scheduling : { TaskScheduling::Dag, TaskScheduling::ForkJoin })
+    {
+        std::string suffix = (scheduling == TaskScheduling::Dag) ? "dag" : "fork_join";
+
+        suite.add("block_lu_" + suffix, [scheduling](Fixture& fixture) -> BenchmarkSuite::Body
+        {
+            return [&A = fixture.A, scheduling]() { return BlockLU(A, BlockFactorization::DEFAULT_BLOCK_SIZE, scheduling).getPivots().back(); };
+        }, nullptr, Metric::GigaflopsPerSecond, [](const Fixture& fixture) { return getGigaflops(fixture, 2.0 / 3.0); });
+
+        suite.add("block_cholesky_" + suffix, [scheduling](Fixture& fixture) -> BenchmarkSuite::Body
+        {
+            return [&A = fixture.A, b = getColumn(fixture.B), scheduling]() { return BlockCholesky(A, BlockFactorization::DEFAULT_BLOCK_SIZE, scheduling).solve(b)[0]; };
+        }, [](MatrixClass matrixClass) { return matrixClass == MatrixClass::SymmetricPositiveDefinite; },
+           Metric::GigaflopsPerSecond, [](const Fixture& fixture) { return getGigaflops(fixture, 1.0 / 3.0); });
+    }
+
+    for (std::string extension : { ".txt", ".npy" })
+    {
+        std::string suffix = extension.substr(1);
+
+        suite.add("write_" + suffix, [extension](Fixture& fixture) -> BenchmarkSuite::Body
+        {
+            return [&A = fixture.A, filepath = fixture.directory + "/write" + extension]()
+            {
+                Matrix::writeToFile(A, filepath);
+                return 0.0;
+            };
+        }, nullptr, Metric::MegabytesPerSecond, [extension](const Fixture& fixture)
+        {
+            std::string filepath = fixture.directory + "/size" + extension;
+            Matrix::writeToFile(fixture.A, filepath);
+            return getMegabytes(filepath);
+        });
+
+        suite.add("read_" + suffix, [extension](Fixture& fixture) -> BenchmarkSuite::Body
+        {
+            std::string filepath = fixture.directory + "/read" + extension;
+            Matrix::writeToFile(fixture.A, filepath);
+
+            return [filepath]() { return Matrix::readFromFile(filepath)[0][0]; };
+        }, nullptr, Metric::MegabytesPerSecond, [extension](const Fixture& fixture) { return getMegabytes(fixture.directory + "/read" + extension); });
+    }
+}
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkSettings settings;
+    RegressionSettings regressionSettings;
+    std::string outputPath;
+    std::string baselinePath;
+
+    try
+    {
+        for (int index = 1; index < argc; ++index)
+        {
+            std::string option = argv[index];
+            if ((option == "-h") || (option == "--help"))
+            {
+                std::cout << USAGE;
+                return 0;
+            }
+
+            if (index + 1 >= argc)
+                throw std::invalid_argument("Missing value for " + option);
+            std::string value = argv[++index];
+
+            if (option == "--sizes")
+            {
+                settings.sizes.clear();
+                for (const std::string& item : split(value))
+                    settings.sizes.push_back(parseCount(option, item));
+            }
+            else if (option == "--classes")
+            {
+                settings.classes.clear();
+                for (const std::string& item : split(value))
+                    settings.classes.push_back(BenchmarkSuite::parseClassName(item));
+            }
+            else if (option == "--warmup")
+                settings.warmup = parseCount(option, value);
+            else if (option == "--repetitions")
+                settings.repetitions = parseCount(option, value);
+            else if ((option == "-t") || (option == "--threads"))
+                settings.numThreads = parseCount(option, value);
+            else if (option == "--runs")
+                settings.runs = parseCount(option, value);
+            else if (option == "--filter")
+                settings.filter = value;
+            else if (option == "--seed")
+                settings.seed = static_cast<unsigned>(parseCount(option, value));
+            else if ((option == "-o") || (option == "--output"))
+                outputPath = value;
+            else if (option == "--baseline")
+                baselinePath = value;
+            else if (option == "--threshold")
+                regressionSettings.threshold = parseCount(option, value) / 100.0;
+            else
+                throw std::invalid_argument("Unknown option: " + option);
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "linear_algebra_benchmarks: " << ex.what() << "\n\n" << USAGE;
+        return 2;
+    }
+
+    try
+    {
+        RegressionCheck check(regressionSettings);
+        std::vector<BenchmarkResult> baseline;
+        if (!baselinePath.empty())
+        {
+            std::ifstream file(baselinePath);
+            if (!file.is_open())
+                throw std::invalid_argument("Failed to open the file: " + baselinePath);
+
+            baseline = BenchmarkSuite::readJson(file);
+        }
+
+        ThreadPool::setNumThreads(settings.numThreads);
+
+        BenchmarkSuite suite(settings);
+        registerBenchmarks(suite);
+
+        std::vector<BenchmarkResult> results = suite.run(&std::cerr);
+
+        if (!outputPath.empty())
+        {
+            std::ofstream file(outputPath);
+            if (!file.is_open())
+                throw std::invalid_argument("Failed to create a file: " + outputPath);
+
+            BenchmarkSuite::writeJson(settings, results, file);
+        }
+        else if (baselinePath.empty())
+        {
+            BenchmarkSuite::writeJson(settings, results, std::cout);
+        }
+
+        if (!baselinePath.empty())
+        {
+            std::vector<Comparison> comparisons = check.compare(baseline, results);
+            RegressionCheck::writeReport(comparisons, std::cout);
+            if (!RegressionCheck::isPassing(comparisons))
+                return 3;
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "linear_algebra_benchmarks: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
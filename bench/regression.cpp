@@ -0,0 +1,175 @@
+#include "regression.h"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+// Scales the median absolute deviation to the standard deviation of a normal distribution.
+constexpr double MAD_TO_SIGMA = 1.4826;
+
+const BenchmarkResult* findResult(const std::vector<BenchmarkResult>& results, const BenchmarkResult& key)
+{
+    for (const BenchmarkResult& result : results)
+        if ((result.name == key.name) && (result.matrixClass == key.matrixClass) && (result.size == key.size))
+            return &result;
+
+    return nullptr;
+}
+
+Comparison createComparison(const BenchmarkResult& result, Verdict verdict)
+{
+    Comparison comparison{ result.name, result.matrixClass, result.size, result.metric };
+    comparison.verdict = verdict;
+    if (verdict == Verdict::Missing)
+        comparison.baseline = result.getValue();
+    else
+        comparison.current = result.getValue();
+
+    return comparison;
+}
+
+std::string formatPercent(double fraction, const char* prefix)
+{
+    std::ostringstream text;
+    text << prefix << std::fixed << std::setprecision(1) << fraction * 100.0 << '%';
+    return text.str();
+}
+
+void writeValue(std::ostream& output, double value, Metric metric)
+{
+    std::ostringstream text;
+    if (metric == Metric::Seconds)
+        text << std::scientific << std::setprecision(3) << value << ' ' << BenchmarkSuite::getMetricName(metric);
+    else
+        text << std::fixed << std::setprecision(2) << value << ' ' << BenchmarkSuite::getMetricName(metric);
+
+    output << std::setw(16) << text.str();
+}
+}
+
+RegressionCheck::RegressionCheck(const RegressionSettings& settings)
+    : settings(settings)
+{
+    if (!(settings.threshold >= 0.0) || !(settings.noiseFactor >= 0.0))
+        throw std::invalid_argument("Regression thresholds should not be negative");
+}
+
+std::vector<Comparison> RegressionCheck::compare(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current) const
+{
+    std::vector<Comparison> comparisons;
+
+    for (const BenchmarkResult& result : current)
+    {
+        const BenchmarkResult* reference = findResult(baseline, result);
+        if (!reference)
+        {
+            comparisons.push_back(createComparison(result, Verdict::New));
+            continue;
+        }
+
+        // Compare seconds per unit of work so that throughput benchmarks whose work differs slightly stay comparable.
+        double before = reference->getMedian() / reference->work;
+        double after = result.getMedian() / result.work;
+        double noise = MAD_TO_SIGMA * std::hypot(reference->getMedianAbsoluteDeviation() / reference->work, result.getMedianAbsoluteDeviation() / result.work);
+        double change = after / before - 1.0;
+        bool isSignificant = std::abs(after - before) > settings.noiseFactor * noise;
+
+        Comparison comparison{ result.name, result.matrixClass, result.size, result.metric };
+        comparison.baseline = reference->getValue();
+        comparison.current = result.getValue();
+        comparison.delta = comparison.current / comparison.baseline - 1.0;
+        comparison.noise = settings.noiseFactor * noise / before;
+
+        if ((change > settings.threshold) && isSignificant)
+            comparison.verdict = Verdict::Regressed;
+        else if ((change < -settings.threshold) && isSignificant)
+            comparison.verdict = Verdict::Improved;
+
+        comparisons.push_back(comparison);
+    }
+
+    for (const BenchmarkResult& reference : baseline)
+        if (!findResult(current, reference))
+            comparisons.push_back(createComparison(reference, Verdict::Missing));
+
+    return comparisons;
+}
+
+bool RegressionCheck::isPassing(const std::vector<Comparison>& comparisons)
+{
+    for (const Comparison& comparison : comparisons)
+        if (comparison.verdict == Verdict::Regressed)
+            return false;
+
+    return true;
+}
+
+void RegressionCheck::writeReport(const std::vector<Comparison>& comparisons, std::ostream& output)
+{
+    size_t counts[5] = {};
+
+    output << std::left << std::setw(28) << "benchmark" << std::setw(22) << "class" << std::right << std::setw(6) << "size"
+           << std::setw(16) << "baseline" << std::setw(16) << "current" << std::setw(10) << "delta" << std::setw(10) << "noise" << "  verdict\n";
+
+    for (const Comparison& comparison : comparisons)
+    {
+        ++counts[static_cast<size_t>(comparison.verdict)];
+
+        output << std::left << std::setw(28) << comparison.name << std::setw(22) << BenchmarkSuite::getClassName(comparison.matrixClass)
+               << std::right << std::setw(6) << comparison.size;
+
+        bool hasBaseline = comparison.verdict != Verdict::New;
+        bool hasCurrent = comparison.verdict != Verdict::Missing;
+
+        if (hasBaseline)
+            writeValue(output, comparison.baseline, comparison.metric);
+        else
+            output << std::setw(16) << '-';
+
+        if (hasCurrent)
+            writeValue(output, comparison.current, comparison.metric);
+        else
+            output << std::setw(16) << '-';
+
+        if (hasBaseline && hasCurrent)
+        {
+            output << std::setw(10) << formatPercent(comparison.delta, (comparison.delta >= 0.0) ? "+" : "")
+                   << std::setw(10) << formatPercent(comparison.noise, "+-");
+        }
+        else
+        {
+            output << std::setw(10) << '-' << std::setw(10) << '-';
+        }
+
+        output << "  " << getVerdictName(comparison.verdict) << '\n';
+    }
+
+    output << '\n' << (isPassing(comparisons) ? "PASS" : "FAIL") << ": "
+           << counts[static_cast<size_t>(Verdict::Regressed)] << " regressed, "
+           << counts[static_cast<size_t>(Verdict::Improved)] << " improved, "
+           << counts[static_cast<size_t>(Verdict::Unchanged)] << " unchanged, "
+           << counts[static_cast<size_t>(Verdict::New)] << " new, "
+           << counts[static_cast<size_t>(Verdict::Missing)] << " missing" << std::endl;
+}
+
+const char* RegressionCheck::getVerdictName(Verdict verdict)
+{
+    switch (verdict)
+    {
+    case Verdict::Unchanged:
+        return "ok";
+    case Verdict::Improved:
+        return "improved";
+    case Verdict::Regressed:
+        return "REGRESSED";
+    case Verdict::New:
+        return "new";
+    case Verdict::Missing:
+        return "missing";
+    }
+
+    return "";
+}
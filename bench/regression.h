@@ -0,0 +1,53 @@
+#ifndef REGRESSION_H
+#define REGRESSION_H
+
+#include "benchmark.h"
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+enum class Verdict
+{
+    Unchanged,
+    Improved,
+    Regressed,
+    New,
+    Missing
+};
+
+struct RegressionSettings
+{
+    double threshold = 0.10;
+    double noiseFactor = 3.0;
+};
+
+struct Comparison
+{
+    std::string name;
+    MatrixClass matrixClass;
+    size_t size;
+    Metric metric;
+    double baseline = 0.0;
+    double current = 0.0;
+    double delta = 0.0;
+    double noise = 0.0;
+    Verdict verdict = Verdict::Unchanged;
+};
+
+class RegressionCheck
+{
+public:
+    explicit RegressionCheck(const RegressionSettings& settings);
+
+    std::vector<Comparison> compare(const std::vector<BenchmarkResult>& baseline, const std::vector<BenchmarkResult>& current) const;
+
+    static bool isPassing(const std::vector<Comparison>& comparisons);
+    static void writeReport(const std::vector<Comparison>& comparisons, std::ostream& output);
+    static const char* getVerdictName(Verdict verdict);
+
+private:
+    RegressionSettings settings;
+};
+
+#endif // REGRESSION_H
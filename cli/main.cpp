@@ -0,0 +1,495 @@
+#include "matrix.h"
+#include "vector.h"
+#include "sle.h"
+#include "profiler.h"
+#include "tiled_matrix.h"
+#include "block_factorization.h"
+#include "reduction.h"
+#include "numa.h"
+#include "aligned_memory.h"
+#include "thread_pool.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+constexpr const char* USAGE =
+    "Usage: sle_solver -A <file> -B <file> [options]\n"
+    "\n"
+    "Solves the system A x = B and writes x together with a timing report.\n"
+    "\n"
+    "Options:\n"
+    "  -A, --matrix <file>         coefficient matrix (.txt, .mtx or .npy)\n"
+    "  -B, --rhs <file>            right-hand side with a single column\n"
+    "  -x, --output <file>         solution file, .npy for binary output (default: x.txt)\n"
+    "  -s, --solver <name>         gauss, gauss-seidel, tiled-lu, block-lu or cholesky (default: gauss)\n"
+    "  -t, --threads <count>       number of worker threads (default: all cores)\n"
+    "      --pin-threads           pin worker threads to NUMA nodes\n"
+    "      --placement <name>      first-touch or interleaved placement of matrix pages (default: first-touch)\n"
+    "      --huge-pages            back buffers of 2 MiB and more with transparent huge pages\n"
+    "      --tolerance <value>     residual at which Gauss-Seidel stops (default: 1e-6)\n"
+    "      --max-iterations <n>    iteration limit for Gauss-Seidel (default: 10000)\n"
+    "      --tile-size <n>         tile size for tiled-lu (default: 256)\n"
+    "      --memory <MiB>          tile cache budget for tiled-lu (default: 256)\n"
+    "      --scratch <file>        backing file for tiled-lu (default: in the temp directory)\n"
+    "      --block-size <n>        block size for block-lu and cholesky (default: 128)\n"
+    "      --schedule <name>       dag or fork-join scheduling of block-lu and cholesky (default: dag)\n"
+    "      --in-place              let gauss overwrite A instead of copying it, the residual re-reads A\n"
+    "      --log <file>            write the step-by-step solution log\n"
+    "      --trace <file>          write a Chrome trace of the run for Perfetto\n"
+    "      --counters              add calling-thread hardware counters to the phases (Linux perf events)\n"
+    "      --reproducible          sum norms and residuals in a fixed order, identical for any thread count\n"
+    "  -r, --report <file>         write the report to a file instead of stdout\n"
+    "  -h, --help                  show this message\n";
+
+class UsageError : public std::invalid_argument
+{
+public:
+    using std::invalid_argument::invalid_argument;
+};
+
+enum class Solver
+{
+    GaussianElimination,
+    GaussSeidel,
+    TiledLU,
+    BlockLU,
+    Cholesky
+};
+
+struct Options
+{
+    std::string matrixPath;
+    std::string rhsPath;
+    std::string outputPath = "x.txt";
+    std::string reportPath;
+    std::string logPath;
+    std::string tracePath;
+    std::string scratchPath;
+    Solver solver = Solver::GaussianElimination;
+    size_t numThreads = ThreadPool::getDefaultNumThreads();
+    size_t tileSize = TiledMatrix::DEFAULT_TILE_SIZE;
+    size_t memoryBudget = TiledMatrix::DEFAULT_MEMORY_BUDGET;
+    size_t blockSize = BlockFactorization::DEFAULT_BLOCK_SIZE;
+    TaskScheduling scheduling = TaskScheduling::Dag;
+    SolverOptions solverOptions;
+    bool hardwareCounters = false;
+    bool reproducible = false;
+    bool pinThreads = false;
+    bool hugePages = false;
+    numa::MemoryPlacement placement = numa::MemoryPlacement::FirstTouch;
+};
+
+struct Report
+{
+    profiler::Profile profile;
+    size_t numRows = 0;
+    size_t numIterations = 0;
+    double residual = 0.0;
+    double loadTime = 0.0;
+    double solveTime = 0.0;
+    double writeTime = 0.0;
+};
+
+class Stopwatch
+{
+public:
+    double lap()
+    {
+        auto now = std::chrono::steady_clock::now();
+        double seconds = std::chrono::duration<double>(now - start).count();
+        start = now;
+        return seconds;
+    }
+
+private:
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+};
+
+const char* getSolverName(Solver solver)
+{
+    switch (solver)
+    {
+    case Solver::GaussianElimination:
+        return "gauss";
+    case Solver::GaussSeidel:
+        return "gauss-seidel";
+    case Solver::TiledLU:
+        return "tiled-lu";
+    case Solver::BlockLU:
+        return "block-lu";
+    case Solver::Cholesky:
+        return "cholesky";
+    }
+
+    return "";
+}
+
+Solver parseSolver(const std::string& name)
+{
+    for (Solver solver : { Solver::GaussianElimination, Solver::GaussSeidel, Solver::TiledLU, Solver::BlockLU, Solver::Cholesky })
+        if (name == getSolverName(solver))
+            return solver;
+
+    throw UsageError("Unknown solver: " + name);
+}
+
+numa::MemoryPlacement parsePlacement(const std::string& name)
+{
+    if (name == "first-touch")
+        return numa::MemoryPlacement::FirstTouch;
+    if (name == "interleaved")
+        return numa::MemoryPlacement::Interleaved;
+
+    throw UsageError("Unknown placement: " + name);
+}
+
+TaskScheduling parseScheduling(const std::string& name)
+{
+    if (name == "dag")
+        return TaskScheduling::Dag;
+    if (name == "fork-join")
+        return TaskScheduling::ForkJoin;
+
+    throw UsageError("Unknown schedule: " + name);
+}
+
+template <typename T>
+T parseNumber(const std::string& option, const std::string& text)
+{
+    std::istringstream input(text);
+    T value;
+    if (!(input >> value) || !input.eof())
+        throw UsageError("Invalid value for " + option + ": " + text);
+
+    return value;
+}
+
+size_t parsePositive(const std::string& option, const std::string& text)
+{
+    long long value = parseNumber<long long>(option, text);
+    if (value <= 0)
+        throw UsageError(option + " should be positive");
+
+    return static_cast<size_t>(value);
+}
+
+Options parseOptions(int argc, char* argv[])
+{
+    Options options;
+    options.solverOptions.reportPath.clear();
+
+    for (int index = 1; index < argc; ++index)
+    {
+        std::string option = argv[index];
+        if ((option == "-h") || (option == "--help"))
+        {
+            std::cout << USAGE;
+            std::exit(EXIT_SUCCESS);
+        }
+
+        if (option == "--counters")
+        {
+            options.hardwareCounters = true;
+            continue;
+        }
+
+        if (option == "--reproducible")
+        {
+            options.reproducible = true;
+            continue;
+        }
+
+        if (option == "--pin-threads")
+        {
+            options.pinThreads = true;
+            continue;
+        }
+
+        if (option == "--huge-pages")
+        {
+            options.hugePages = true;
+            continue;
+        }
+
+        if (option == "--in-place")
+        {
+            options.solverOptions.factorInPlace = true;
+            continue;
+        }
+
+        if (index + 1 >= argc)
+            throw UsageError("Missing value for " + option);
+        std::string value = argv[++index];
+
+        if ((option == "-A") || (option == "--matrix"))
+            options.matrixPath = value;
+        else if ((option == "-B") || (option == "--rhs"))
+            options.rhsPath = value;
+        else if ((option == "-x") || (option == "--output"))
+            options.outputPath = value;
+        else if ((option == "-s") || (option == "--solver"))
+            options.solver = parseSolver(value);
+        else if ((option == "-t") || (option == "--threads"))
+            options.numThreads = parsePositive(option, value);
+        else if (option == "--tolerance")
+            options.solverOptions.tolerance = parseNumber<double>(option, value);
+        else if (option == "--max-iterations")
+            options.solverOptions.maxIterations = parsePositive(option, value);
+        else if (option == "--tile-size")
+            options.tileSize = parsePositive(option, value);
+        else if (option == "--memory")
+            options.memoryBudget = parsePositive(option, value) << 20;
+        else if (option == "--scratch")
+            options.scratchPath = value;
+        else if (option == "--block-size")
+            options.blockSize = parsePositive(option, value);
+        else if (option == "--schedule")
+            options.scheduling = parseScheduling(value);
+        else if (option == "--placement")
+            options.placement = parsePlacement(value);
+        else if (option == "--log")
+            options.solverOptions.reportPath = value;
+        else if (option == "--trace")
+            options.tracePath = value;
+        else if ((option == "-r") || (option == "--report"))
+            options.reportPath = value;
+        else
+            throw UsageError("Unknown option: " + option);
+    }
+
+    if (options.matrixPath.empty() || options.rhsPath.empty())
+        throw UsageError("Both -A and -B are required");
+    if (!(options.solverOptions.tolerance > 0.0))
+        throw UsageError("--tolerance should be positive");
+
+    return options;
+}
+
+Matrix loadMatrix(const std::string& filepath, MappingMode mode = MappingMode::ReadOnly)
+{
+    if (std::filesystem::path(filepath).extension() == ".npy")
+        return Matrix::mapFromFile(filepath, mode);
+
+    return Matrix::readFromFile(filepath);
+}
+
+Vector getColumn(const Matrix& matrix)
+{
+    if ((matrix.getNumRows() == 0) || (matrix.getNumColumns() != 1))
+        throw std::runtime_error("Wrong size of B matrix, matrix B should have only 1 column");
+
+    Vector column(matrix.getNumRows());
+    for (size_t i = 0; i < matrix.getNumRows(); ++i)
+        column[i] = matrix[i][0];
+
+    return column;
+}
+
+double calculateResidual(const Matrix& A, const Vector& b, const Vector& x)
+{
+    double residual = 0.0;
+    for (size_t i = 0; i < A.getNumRows(); ++i)
+    {
+        const Vector& row = A[i];
+
+        double sum = 0.0;
+        for (size_t j = 0; j < row.size(); ++j)
+            sum += row[j] * x[j];
+
+        residual += (b[i] - sum) * (b[i] - sum);
+    }
+
+    return std::sqrt(residual);
+}
+
+Vector solveTiled(const Options& options, const Matrix& A, const Vector& b)
+{
+    std::filesystem::path scratchPath = options.scratchPath;
+    if (scratchPath.empty())
+        scratchPath = std::filesystem::temp_directory_path() / ("sle_solver_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()) + ".tiles");
+
+    Vector x;
+    try
+    {
+        TiledMatrix tiled(scratchPath.string(), A.getNumRows(), A.getNumColumns(), options.tileSize, options.memoryBudget);
+        tiled.importMatrix(A);
+        x = tiled.solve(b);
+    }
+    catch (...)
+    {
+        std::error_code error;
+        std::filesystem::remove(scratchPath, error);
+        throw;
+    }
+
+    std::error_code error;
+    std::filesystem::remove(scratchPath, error);
+
+    return x;
+}
+
+void writeReport(const Options& options, const Report& report, std::ostream& output)
+{
+    output << std::setprecision(6);
+    output << "{\n";
+    output << "  \"solver\": \"" << getSolverName(options.solver) << "\",\n";
+    output << "  \"size\": " << report.numRows << ",\n";
+    output << "  \"threads\": " << options.numThreads << ",\n";
+    output << "  \"iterations\": " << report.numIterations << ",\n";
+    output << "  \"residual\": " << report.residual << ",\n";
+    output << "  \"timings\": {\n";
+    output << "    \"load_seconds\": " << report.loadTime << ",\n";
+    output << "    \"solve_seconds\": " << report.solveTime << ",\n";
+    output << "    \"write_seconds\": " << report.writeTime << ",\n";
+    output << "    \"total_seconds\": " << report.loadTime + report.solveTime + report.writeTime << "\n";
+    output << "  },\n";
+    output << "  \"phases\": [";
+
+    const auto& phases = report.profile.getPhases();
+    for (size_t index = 0; index < phases.size(); ++index)
+    {
+        const profiler::PhaseProfile& phase = phases[index];
+        output << (index ? ",\n" : "\n");
+        output << "    { \"name\": \"" << phase.name << "\", \"calls\": " << phase.calls << ", \"seconds\": " << phase.seconds
+               << ", \"flops\": " << phase.flops << ", \"bytes\": " << phase.bytes << ", \"iterations\": " << phase.iterations;
+
+        if (!phase.counters.empty())
+        {
+            output << ", \"counters\": { \"scope\": \"calling_thread\",";
+            for (size_t event = 0; event < profiler::NUM_HARDWARE_EVENTS; ++event)
+                if (phase.counters.available[event])
+                    output << " \"" << profiler::getHardwareEventName(static_cast<profiler::HardwareEvent>(event)) << "\": " << phase.counters.values[event] << ",";
+            output << " \"ipc\": " << phase.counters.getInstructionsPerCycle() << " }";
+        }
+
+        output << " }";
+    }
+
+    output << (phases.empty() ? "]\n" : "\n  ]\n");
+    output << "}\n";
+}
+
+void run(const Options& options)
+{
+    ThreadPool::setAffinity(options.pinThreads ? ThreadAffinity::NumaNodes : ThreadAffinity::None);
+    ThreadPool::setNumThreads(options.numThreads);
+    numa::setMemoryPlacement(options.placement);
+    setHugePagesEnabled(options.hugePages);
+    setReductionMode(options.reproducible ? ReductionMode::Reproducible : ReductionMode::Fast);
+
+    Report report;
+    PROFILE_SESSION(report.profile);
+    Stopwatch stopwatch;
+
+    if (options.hardwareCounters && !profiler::enableHardwareCounters())
+        std::cerr << "sle_solver: hardware counters are unavailable (" << profiler::getHardwareCountersError() << ")" << std::endl;
+
+    if (!options.tracePath.empty())
+    {
+        profiler::startTracing();
+        profiler::setThreadName("main");
+    }
+
+    Matrix A = loadMatrix(options.matrixPath, options.solverOptions.factorInPlace ? MappingMode::CopyOnWrite : MappingMode::ReadOnly);
+    Vector b = getColumn(loadMatrix(options.rhsPath));
+    if ((A.getNumRows() != b.size()) || (A.getNumColumns() != A.getNumRows()))
+        throw std::runtime_error("Matrix A should be square with as many rows as B");
+
+    report.numRows = A.getNumRows();
+    report.loadTime = stopwatch.lap();
+
+    Vector x;
+    if (options.solver == Solver::TiledLU)
+    {
+        x = solveTiled(options, A, b);
+    }
+    else if (options.solver == Solver::BlockLU)
+    {
+        x = BlockLU(A, options.blockSize, options.scheduling).solve(b);
+    }
+    else if (options.solver == Solver::Cholesky)
+    {
+        x = BlockCholesky(A, options.blockSize, options.scheduling).solve(b);
+    }
+    else
+    {
+        Matrix B(static_cast<int>(b.size()), 1);
+        for (size_t i = 0; i < b.size(); ++i)
+            B[i][0] = b[i];
+
+        SLE sle;
+        sle.setOptions(options.solverOptions);
+        sle.setMatrixA(std::move(A));
+        sle.setMatrixB(std::move(B));
+
+        if (options.solver == Solver::GaussSeidel)
+            sle.solveGaussSeidelMethod();
+        else
+            sle.solveGaussianElimination();
+
+        x = sle.takeVectorX();
+        report.numIterations = sle.getNumIterations();
+        report.profile.merge(sle.getProfile());
+
+        bool isFactored = options.solverOptions.factorInPlace && (options.solver == Solver::GaussianElimination);
+        if (!isFactored)
+            A = sle.takeMatrixA();
+    }
+
+    report.solveTime = stopwatch.lap();
+    if (A.getNumRows() == 0)
+        A = loadMatrix(options.matrixPath);
+    report.residual = calculateResidual(A, b, x);
+
+    Vector::writeToFile(x, options.outputPath);
+    report.writeTime = stopwatch.lap();
+
+    if (!options.tracePath.empty())
+    {
+        profiler::stopTracing();
+        profiler::writeChromeTrace(options.tracePath);
+    }
+
+    if (options.reportPath.empty())
+    {
+        writeReport(options, report, std::cout);
+        return;
+    }
+
+    std::ofstream file(options.reportPath);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to create a file: " + options.reportPath);
+
+    writeReport(options, report, file);
+}
+}
+
+int main(int argc, char* argv[])
+{
+    try
+    {
+        run(parseOptions(argc, argv));
+    }
+    catch (const UsageError& ex)
+    {
+        std::cerr << "sle_solver: " << ex.what() << "\n\n" << USAGE;
+        return 2;
+    }
+    catch (const std::exception& ex)
+    {
+        std::cerr << "sle_solver: " << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,117 @@
+#include "aligned_memory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace
+{
+// Buffers this far apart map to the same L1 sets
+constexpr size_t CONFLICT_STRIDE = 4096;
+// Large blocks start at one of this many cache lines into their first page
+constexpr size_t NUM_START_OFFSETS = 8;
+// Rows of a tile that are a multiple of this apart share sets after only a few rows
+constexpr size_t ROW_CONFLICT_STRIDE = 512;
+
+std::atomic<bool> hugePagesEnabled{ false };
+std::atomic<size_t> nextStartOffset{ 0 };
+
+size_t roundUp(size_t value, size_t multiple)
+{
+    return (value + multiple - 1) / multiple * multiple;
+}
+
+bool isStaggered(size_t bytes)
+{
+    return bytes >= CONFLICT_STRIDE;
+}
+
+void* allocateBlock(size_t alignment, size_t size)
+{
+#ifdef _WIN32
+    void* pointer = _aligned_malloc(size, alignment);
+#else
+    void* pointer = nullptr;
+    if (posix_memalign(&pointer, alignment, size) != 0)
+        pointer = nullptr;
+#endif
+    if (!pointer)
+        throw std::bad_alloc();
+
+    return pointer;
+}
+
+void deallocateBlock(void* pointer)
+{
+#ifdef _WIN32
+    _aligned_free(pointer);
+#else
+    std::free(pointer);
+#endif
+}
+}
+
+void* allocateAligned(size_t bytes)
+{
+    size_t size = roundUp(std::max<size_t>(bytes, 1), CACHE_LINE_SIZE);
+    if (!isStaggered(bytes))
+        return allocateBlock(CACHE_LINE_SIZE, size);
+
+    // The base is page aligned whether it comes from the heap or from mmap, so the offset alone picks the
+    // L1 sets of the first line. The line before the returned pointer keeps the base for deallocation.
+    size_t startOffset = (1 + nextStartOffset.fetch_add(1, std::memory_order_relaxed) % NUM_START_OFFSETS) * CACHE_LINE_SIZE;
+    size += startOffset;
+
+    size_t alignment = CONFLICT_STRIDE;
+    bool huge = areHugePagesEnabled() && (bytes >= HUGE_PAGE_SIZE);
+    if (huge)
+    {
+        alignment = HUGE_PAGE_SIZE;
+        size = roundUp(size, HUGE_PAGE_SIZE);
+    }
+
+    char* block = static_cast<char*>(allocateBlock(alignment, size));
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+    if (huge)
+        madvise(block, size, MADV_HUGEPAGE);
+#endif
+
+    char* pointer = block + startOffset;
+    reinterpret_cast<void**>(pointer)[-1] = block;
+    return pointer;
+}
+
+void deallocateAligned(void* pointer, size_t bytes)
+{
+    if (!pointer)
+        return;
+
+    deallocateBlock(isStaggered(bytes) ? reinterpret_cast<void**>(pointer)[-1] : pointer);
+}
+
+void setHugePagesEnabled(bool enabled)
+{
+    hugePagesEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool areHugePagesEnabled()
+{
+    return hugePagesEnabled.load(std::memory_order_relaxed);
+}
+
+size_t getPaddedLeadingDimension(size_t numColumns)
+{
+    size_t elementsPerLine = CACHE_LINE_SIZE / sizeof(double);
+    size_t padded = roundUp(std::max<size_t>(numColumns, 1), elementsPerLine);
+    if ((padded * sizeof(double)) % ROW_CONFLICT_STRIDE == 0)
+        padded += elementsPerLine;
+
+    return padded;
+}
@@ -0,0 +1,66 @@
+#ifndef ALIGNEDMEMORY_H
+#define ALIGNEDMEMORY_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+constexpr size_t CACHE_LINE_SIZE = 64;
+constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+// Cache-line aligned memory. Blocks of a page or more start a rotating number of cache lines past a
+// page boundary, so consecutively allocated rows start on different L1 sets wherever the system
+// allocator places them. Buffers of at least a huge page are backed by transparent huge pages while
+// they are enabled. Blocks are freed with the size they were allocated with.
+void* allocateAligned(size_t bytes);
+void deallocateAligned(void* pointer, size_t bytes);
+
+void setHugePagesEnabled(bool enabled);
+bool areHugePagesEnabled();
+
+// Row length in elements that keeps rows cache-line aligned without a power-of-two stride
+size_t getPaddedLeadingDimension(size_t numColumns);
+
+template <typename T>
+class AlignedAllocator
+{
+public:
+    using value_type = T;
+
+    AlignedAllocator() = default;
+
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U>&)
+    {
+    }
+
+    T* allocate(size_t count)
+    {
+        if (count > static_cast<size_t>(-1) / sizeof(T))
+            throw std::bad_array_new_length();
+
+        return static_cast<T*>(allocateAligned(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t count)
+    {
+        deallocateAligned(pointer, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const AlignedAllocator<U>&) const
+    {
+        return true;
+    }
+
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U>&) const
+    {
+        return false;
+    }
+};
+
+template <typename T>
+using AlignedVector = std::vector<T, AlignedAllocator<T>>;
+
+#endif // ALIGNEDMEMORY_H
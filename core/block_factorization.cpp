@@ -0,0 +1,350 @@
+#include "block_factorization.h"
+
+#include "profiler.h"
+#include "task_graph.h"
+#include "thread_pool.h"
+#include "tile_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+// Kernels on the same block column share a level, the panel work of a level comes before its updates.
+constexpr int PRIORITY_LEVELS = 3;
+}
+
+BlockFactorization::BlockFactorization(const Matrix& matrix, size_t blockSize)
+    : size(matrix.getNumRows())
+    , blockSize(blockSize)
+    , leadingDimension(getPaddedLeadingDimension(blockSize))
+    , numBlocks(0)
+{
+    if (matrix.getNumRows() != matrix.getNumColumns())
+        throw std::invalid_argument("Only square matrices can be factorized");
+
+    if (blockSize == 0)
+        throw std::invalid_argument("Block size must be positive");
+
+    numBlocks = (size + blockSize - 1) / blockSize;
+    values.assign(numBlocks * numBlocks * blockSize * leadingDimension, 0.0);
+
+    for (size_t i = 0; i < size; ++i)
+    {
+        const Vector& row = matrix[i];
+        for (size_t j = 0; j < size; ++j)
+            element(i, j) = row[j];
+    }
+}
+
+size_t BlockFactorization::getSize() const
+{
+    return size;
+}
+
+size_t BlockFactorization::getBlockSize() const
+{
+    return blockSize;
+}
+
+size_t BlockFactorization::getNumBlocks() const
+{
+    return numBlocks;
+}
+
+double* BlockFactorization::block(size_t blockRow, size_t blockColumn)
+{
+    return values.data() + getBlockKey(blockRow, blockColumn) * blockSize * leadingDimension;
+}
+
+const double* BlockFactorization::block(size_t blockRow, size_t blockColumn) const
+{
+    return values.data() + getBlockKey(blockRow, blockColumn) * blockSize * leadingDimension;
+}
+
+size_t BlockFactorization::getBlockKey(size_t blockRow, size_t blockColumn) const
+{
+    return blockRow * numBlocks + blockColumn;
+}
+
+size_t BlockFactorization::getBlockWidth(size_t index) const
+{
+    return std::min(blockSize, size - index * blockSize);
+}
+
+int BlockFactorization::getPriority(size_t blockColumn, int bonus) const
+{
+    return static_cast<int>(numBlocks - blockColumn) * PRIORITY_LEVELS + bonus;
+}
+
+double& BlockFactorization::element(size_t rowIndex, size_t columnIndex)
+{
+    return block(rowIndex / blockSize, columnIndex / blockSize)[(rowIndex % blockSize) * leadingDimension + columnIndex % blockSize];
+}
+
+double BlockFactorization::element(size_t rowIndex, size_t columnIndex) const
+{
+    return block(rowIndex / blockSize, columnIndex / blockSize)[(rowIndex % blockSize) * leadingDimension + columnIndex % blockSize];
+}
+
+BlockLU::BlockLU(const Matrix& matrix, size_t blockSize /*= DEFAULT_BLOCK_SIZE*/, TaskScheduling scheduling /*= TaskScheduling::Dag*/)
+    : BlockFactorization(matrix, blockSize)
+    , pivots(size)
+{
+    PROFILE_SCOPE("block_lu");
+    PROFILE_FLOPS(2 * static_cast<uint64_t>(size) * size * size / 3);
+
+    if (scheduling == TaskScheduling::ForkJoin)
+    {
+        for (size_t k = 0; k < numBlocks; ++k)
+        {
+            size_t numTrailing = numBlocks - k - 1;
+
+            factorizePanel(k);
+            parallelFor(k + 1, numBlocks, 1, [&](size_t begin, size_t end)
+            {
+                for (size_t j = begin; j < end; ++j)
+                    updateRowPanel(k, j);
+            });
+            parallelFor(0, numTrailing * numTrailing, 1, [&](size_t begin, size_t end)
+            {
+                for (size_t index = begin; index < end; ++index)
+                    updateTrailing(k + 1 + index / numTrailing, k + 1 + index % numTrailing, k);
+            });
+        }
+        return;
+    }
+
+    TaskGraph graph;
+    for (size_t k = 0; k < numBlocks; ++k)
+    {
+        std::vector<TaskGraph::Dependency> panel;
+        for (size_t i = k; i < numBlocks; ++i)
+            panel.push_back({ getBlockKey(i, k), DataAccess::Write });
+        graph.add(getPriority(k, 2), panel, [this, k]() { factorizePanel(k); });
+
+        for (size_t j = k + 1; j < numBlocks; ++j)
+        {
+            // The row interchanges of the panel touch every block below the diagonal in this column
+            std::vector<TaskGraph::Dependency> rowPanel = { { getBlockKey(k, k), DataAccess::Read } };
+            for (size_t i = k; i < numBlocks; ++i)
+                rowPanel.push_back({ getBlockKey(i, j), DataAccess::Write });
+            graph.add(getPriority(j, 1), rowPanel, [this, k, j]() { updateRowPanel(k, j); });
+        }
+
+        for (size_t j = k + 1; j < numBlocks; ++j)
+            for (size_t i = k + 1; i < numBlocks; ++i)
+            {
+                graph.add(getPriority(j, 0),
+                          { { getBlockKey(i, k), DataAccess::Read }, { getBlockKey(k, j), DataAccess::Read }, { getBlockKey(i, j), DataAccess::Write } },
+                          [this, i, j, k]() { updateTrailing(i, j, k); });
+            }
+    }
+
+    graph.run();
+}
+
+const std::vector<size_t>& BlockLU::getPivots() const
+{
+    return pivots;
+}
+
+Vector BlockLU::solve(const Vector& b) const
+{
+    if (b.size() != size)
+        throw std::invalid_argument("Wrong size of the right-hand side");
+
+    PROFILE_SCOPE("block_lu_solve");
+    PROFILE_FLOPS(2 * static_cast<uint64_t>(size) * size);
+
+    Vector x(b);
+    for (size_t k = 0; k < numBlocks; ++k)
+    {
+        size_t first = k * blockSize;
+        size_t last = first + getBlockWidth(k);
+
+        for (size_t row = first; row < last; ++row)
+            std::swap(x[row], x[pivots[row]]);
+
+        for (size_t row = first + 1; row < size; ++row)
+        {
+            double sum = x[row];
+            for (size_t column = first; column < std::min(row, last); ++column)
+                sum -= element(row, column) * x[column];
+            x[row] = sum;
+        }
+    }
+
+    for (size_t row = size; row-- > 0;)
+    {
+        double sum = x[row];
+        for (size_t column = row + 1; column < size; ++column)
+            sum -= element(row, column) * x[column];
+        x[row] = sum / element(row, row);
+    }
+
+    return x;
+}
+
+void BlockLU::factorizePanel(size_t k)
+{
+    PROFILE_TRACE("panel_factorization");
+    size_t width = getBlockWidth(k);
+
+    auto panelRow = [&](size_t row) { return block(row / blockSize, k) + (row % blockSize) * leadingDimension; };
+
+    for (size_t column = 0; column < width; ++column)
+    {
+        size_t diagonal = k * blockSize + column;
+
+        size_t pivot = diagonal;
+        for (size_t row = diagonal + 1; row < size; ++row)
+            if (std::abs(panelRow(row)[column]) > std::abs(panelRow(pivot)[column]))
+                pivot = row;
+
+        pivots[diagonal] = pivot;
+        if (pivot != diagonal)
+            std::swap_ranges(panelRow(diagonal), panelRow(diagonal) + width, panelRow(pivot));
+
+        const double* pivotRow = panelRow(diagonal);
+        if (pivotRow[column] == 0.0)
+            throw std::runtime_error("Matrix is singular");
+
+        for (size_t row = diagonal + 1; row < size; ++row)
+        {
+            double* rowValues = panelRow(row);
+
+            rowValues[column] /= pivotRow[column];
+            for (size_t c = column + 1; c < width; ++c)
+                rowValues[c] -= rowValues[column] * pivotRow[c];
+        }
+    }
+}
+
+void BlockLU::updateRowPanel(size_t k, size_t j)
+{
+    PROFILE_TRACE("triangular_solve");
+    size_t width = getBlockWidth(j);
+
+    for (size_t row = k * blockSize; row < k * blockSize + getBlockWidth(k); ++row)
+    {
+        size_t pivot = pivots[row];
+        if (pivot == row)
+            continue;
+
+        double* first = block(row / blockSize, j) + (row % blockSize) * leadingDimension;
+        double* second = block(pivot / blockSize, j) + (pivot % blockSize) * leadingDimension;
+        std::swap_ranges(first, first + width, second);
+    }
+
+    kernels::solveUnitLower(block(k, k), block(k, j), getBlockWidth(k), width, leadingDimension);
+}
+
+void BlockLU::updateTrailing(size_t i, size_t j, size_t k)
+{
+    PROFILE_TRACE("trailing_update");
+    kernels::multiplySubtract(block(i, j), block(i, k), block(k, j), getBlockWidth(i), getBlockWidth(j), getBlockWidth(k), leadingDimension);
+}
+
+BlockCholesky::BlockCholesky(const Matrix& matrix, size_t blockSize /*= DEFAULT_BLOCK_SIZE*/, TaskScheduling scheduling /*= TaskScheduling::Dag*/)
+    : BlockFactorization(matrix, blockSize)
+{
+    PROFILE_SCOPE("block_cholesky");
+    PROFILE_FLOPS(static_cast<uint64_t>(size) * size * size / 3);
+
+    if (scheduling == TaskScheduling::ForkJoin)
+    {
+        for (size_t k = 0; k < numBlocks; ++k)
+        {
+            size_t numTrailing = numBlocks - k - 1;
+
+            factorizeDiagonal(k);
+            parallelFor(k + 1, numBlocks, 1, [&](size_t begin, size_t end)
+            {
+                for (size_t i = begin; i < end; ++i)
+                    solvePanel(i, k);
+            });
+            parallelFor(0, numTrailing * numTrailing, 1, [&](size_t begin, size_t end)
+            {
+                for (size_t index = begin; index < end; ++index)
+                {
+                    size_t i = k + 1 + index / numTrailing;
+                    size_t j = k + 1 + index % numTrailing;
+                    if (j <= i)
+                        updateTrailing(i, j, k);
+                }
+            });
+        }
+        return;
+    }
+
+    TaskGraph graph;
+    for (size_t k = 0; k < numBlocks; ++k)
+    {
+        graph.add(getPriority(k, 2), { { getBlockKey(k, k), DataAccess::Write } }, [this, k]() { factorizeDiagonal(k); });
+
+        for (size_t i = k + 1; i < numBlocks; ++i)
+        {
+            graph.add(getPriority(i, 1), { { getBlockKey(k, k), DataAccess::Read }, { getBlockKey(i, k), DataAccess::Write } },
+                      [this, i, k]() { solvePanel(i, k); });
+        }
+
+        for (size_t j = k + 1; j < numBlocks; ++j)
+            for (size_t i = j; i < numBlocks; ++i)
+            {
+                graph.add(getPriority(j, 0),
+                          { { getBlockKey(i, k), DataAccess::Read }, { getBlockKey(j, k), DataAccess::Read }, { getBlockKey(i, j), DataAccess::Write } },
+                          [this, i, j, k]() { updateTrailing(i, j, k); });
+            }
+    }
+
+    graph.run();
+}
+
+Vector BlockCholesky::solve(const Vector& b) const
+{
+    if (b.size() != size)
+        throw std::invalid_argument("Wrong size of the right-hand side");
+
+    PROFILE_SCOPE("block_cholesky_solve");
+    PROFILE_FLOPS(2 * static_cast<uint64_t>(size) * size);
+
+    Vector x(b);
+    for (size_t row = 0; row < size; ++row)
+    {
+        double sum = x[row];
+        for (size_t column = 0; column < row; ++column)
+            sum -= element(row, column) * x[column];
+        x[row] = sum / element(row, row);
+    }
+
+    for (size_t row = size; row-- > 0;)
+    {
+        double sum = x[row];
+        for (size_t column = row + 1; column < size; ++column)
+            sum -= element(column, row) * x[column];
+        x[row] = sum / element(row, row);
+    }
+
+    return x;
+}
+
+void BlockCholesky::factorizeDiagonal(size_t k)
+{
+    PROFILE_TRACE("diagonal_factorization");
+    if (!kernels::factorizeCholesky(block(k, k), getBlockWidth(k), leadingDimension))
+        throw std::runtime_error("Matrix is not positive definite");
+}
+
+void BlockCholesky::solvePanel(size_t i, size_t k)
+{
+    PROFILE_TRACE("triangular_solve");
+    kernels::solveLowerTransposedRight(block(k, k), block(i, k), getBlockWidth(i), getBlockWidth(k), leadingDimension);
+}
+
+void BlockCholesky::updateTrailing(size_t i, size_t j, size_t k)
+{
+    PROFILE_TRACE(i == j ? "symmetric_update" : "trailing_update");
+    kernels::multiplyTransposedSubtract(block(i, j), block(i, k), block(j, k), getBlockWidth(i), getBlockWidth(j), getBlockWidth(k), leadingDimension);
+}
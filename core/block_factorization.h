@@ -0,0 +1,77 @@
+#ifndef BLOCKFACTORIZATION_H
+#define BLOCKFACTORIZATION_H
+
+#include "matrix.h"
+#include "vector.h"
+#include "aligned_memory.h"
+
+#include <cstddef>
+#include <vector>
+
+enum class TaskScheduling
+{
+    Dag,
+    ForkJoin
+};
+
+class BlockFactorization
+{
+public:
+    static constexpr size_t DEFAULT_BLOCK_SIZE = 128;
+
+    size_t getSize() const;
+    size_t getBlockSize() const;
+    size_t getNumBlocks() const;
+
+protected:
+    BlockFactorization(const Matrix& matrix, size_t blockSize);
+
+    double* block(size_t blockRow, size_t blockColumn);
+    const double* block(size_t blockRow, size_t blockColumn) const;
+    size_t getBlockKey(size_t blockRow, size_t blockColumn) const;
+    size_t getBlockWidth(size_t index) const;
+    int getPriority(size_t blockColumn, int bonus) const;
+
+    double& element(size_t rowIndex, size_t columnIndex);
+    double element(size_t rowIndex, size_t columnIndex) const;
+
+    size_t size;
+    size_t blockSize;
+    size_t leadingDimension;
+    size_t numBlocks;
+    AlignedVector<double> values;
+};
+
+// Tile LU factorization with partial pivoting. Every tile kernel is a task, so the DAG schedule
+// can factorize the next panels while the trailing updates of the previous ones are still running.
+class BlockLU : public BlockFactorization
+{
+public:
+    explicit BlockLU(const Matrix& matrix, size_t blockSize = DEFAULT_BLOCK_SIZE, TaskScheduling scheduling = TaskScheduling::Dag);
+
+    const std::vector<size_t>& getPivots() const;
+    Vector solve(const Vector& b) const;
+
+private:
+    void factorizePanel(size_t k);
+    void updateRowPanel(size_t k, size_t j);
+    void updateTrailing(size_t i, size_t j, size_t k);
+
+    std::vector<size_t> pivots;
+};
+
+// Tile Cholesky factorization of a symmetric positive definite matrix, only the lower triangle is read.
+class BlockCholesky : public BlockFactorization
+{
+public:
+    explicit BlockCholesky(const Matrix& matrix, size_t blockSize = DEFAULT_BLOCK_SIZE, TaskScheduling scheduling = TaskScheduling::Dag);
+
+    Vector solve(const Vector& b) const;
+
+private:
+    void factorizeDiagonal(size_t k);
+    void solvePanel(size_t i, size_t k);
+    void updateTrailing(size_t i, size_t j, size_t k);
+};
+
+#endif // BLOCKFACTORIZATION_H
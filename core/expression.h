@@ -0,0 +1,296 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include "profiler.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+class Matrix;
+class Vector;
+
+// Element-wise arithmetic on Matrix and Vector builds a tree of these nodes, and the tree is evaluated
+// in a single pass over the rows when it is assigned to a Matrix or Vector.
+namespace expression
+{
+constexpr size_t ELEMENTS_PER_TASK = 1 << 14;
+
+struct Node
+{
+};
+
+template <typename T, typename = void>
+struct ResultOf
+{
+    using Type = T;
+};
+
+template <typename T>
+struct ResultOf<T, std::enable_if_t<std::is_base_of_v<Node, T>>>
+{
+    using Type = typename T::Result;
+};
+
+template <typename T>
+using ResultType = typename ResultOf<std::decay_t<T>>::Type;
+
+template <typename T>
+constexpr bool isExpression = std::is_base_of_v<Node, std::decay_t<T>>;
+
+template <typename T>
+constexpr bool isOperand = std::is_same_v<ResultType<T>, Matrix> || std::is_same_v<ResultType<T>, Vector>;
+
+struct Add
+{
+    static double apply(double lhs, double rhs) { return lhs + rhs; }
+};
+
+struct Subtract
+{
+    static double apply(double lhs, double rhs) { return lhs - rhs; }
+};
+
+struct Multiply
+{
+    static double apply(double lhs, double rhs) { return lhs * rhs; }
+};
+
+// A row of a node is anything indexable by column, so a whole tree inlines into one loop over raw pointers
+template <typename Operation, typename LhsRow, typename RhsRow>
+struct BinaryRow
+{
+    LhsRow lhs;
+    RhsRow rhs;
+
+    double operator[](size_t index) const { return Operation::apply(lhs[index], rhs[index]); }
+};
+
+struct ScalarRow
+{
+    double value;
+
+    double operator[](size_t) const { return value; }
+};
+
+// Holds a Matrix or Vector, by reference for lvalues and by value for temporaries such as a product
+template <typename Storage>
+class Terminal : public Node
+{
+public:
+    using Result = std::decay_t<Storage>;
+
+    static constexpr size_t NUM_OPERATIONS = 0;
+    static constexpr size_t NUM_OPERANDS = 1;
+
+    explicit Terminal(Storage value)
+        : value(std::forward<Storage>(value))
+    {
+    }
+
+    size_t getNumRows() const
+    {
+        if constexpr (std::is_same_v<Result, Vector>)
+            return 1;
+        else
+            return value.getNumRows();
+    }
+
+    size_t getNumColumns() const
+    {
+        if constexpr (std::is_same_v<Result, Vector>)
+            return value.size();
+        else
+            return value.getNumColumns();
+    }
+
+    const double* getRow(size_t index) const
+    {
+        if constexpr (std::is_same_v<Result, Vector>)
+            return value.begin();
+        else
+            return value[index].begin();
+    }
+
+    Result* getReusableStorage()
+    {
+        if constexpr (std::is_reference_v<Storage>)
+            return nullptr;
+        else
+            return &value;
+    }
+
+private:
+    Storage value;
+};
+
+template <typename T>
+class Scalar : public Node
+{
+public:
+    using Result = T;
+
+    static constexpr size_t NUM_OPERATIONS = 0;
+    static constexpr size_t NUM_OPERANDS = 0;
+
+    Scalar(double value, size_t numRows, size_t numColumns)
+        : value(value)
+        , numRows(numRows)
+        , numColumns(numColumns)
+    {
+    }
+
+    size_t getNumRows() const { return numRows; }
+    size_t getNumColumns() const { return numColumns; }
+    ScalarRow getRow(size_t) const { return { value }; }
+    T* getReusableStorage() { return nullptr; }
+
+private:
+    double value;
+    size_t numRows;
+    size_t numColumns;
+};
+
+template <typename Operation, typename Lhs, typename Rhs>
+class Binary : public Node
+{
+public:
+    static_assert(std::is_same_v<typename Lhs::Result, typename Rhs::Result>, "Matrices and vectors can't be mixed in one expression");
+
+    using Result = typename Lhs::Result;
+
+    static constexpr size_t NUM_OPERATIONS = Lhs::NUM_OPERATIONS + Rhs::NUM_OPERATIONS + 1;
+    static constexpr size_t NUM_OPERANDS = Lhs::NUM_OPERANDS + Rhs::NUM_OPERANDS;
+
+    Binary(Lhs lhs, Rhs rhs)
+        : lhs(std::move(lhs))
+        , rhs(std::move(rhs))
+    {
+        if ((this->lhs.getNumRows() != this->rhs.getNumRows()) || (this->lhs.getNumColumns() != this->rhs.getNumColumns()))
+            throw std::invalid_argument(std::is_same_v<Result, Vector> ? "Vectors have different sizes" : "Matrices have different sizes");
+    }
+
+    size_t getNumRows() const { return lhs.getNumRows(); }
+    size_t getNumColumns() const { return lhs.getNumColumns(); }
+
+    auto getRow(size_t index) const
+    {
+        using Row = BinaryRow<Operation, decltype(lhs.getRow(index)), decltype(rhs.getRow(index))>;
+        return Row{ lhs.getRow(index), rhs.getRow(index) };
+    }
+
+    // Every operand has the shape of the whole expression, so a temporary owned by the tree can receive the result
+    Result* getReusableStorage()
+    {
+        Result* storage = lhs.getReusableStorage();
+        return storage ? storage : rhs.getReusableStorage();
+    }
+
+private:
+    Lhs lhs;
+    Rhs rhs;
+};
+
+template <typename T>
+auto makeOperand(T&& value)
+{
+    using Type = std::decay_t<T>;
+
+    if constexpr (isExpression<Type>)
+        return Type(std::forward<T>(value));
+    else if constexpr (std::is_lvalue_reference_v<T>)
+        return Terminal<const Type&>(value);
+    else
+        return Terminal<Type>(std::move(value));
+}
+
+template <typename Operation, typename Lhs, typename Rhs>
+auto makeBinary(Lhs&& lhs, Rhs&& rhs)
+{
+    auto lhsOperand = makeOperand(std::forward<Lhs>(lhs));
+    auto rhsOperand = makeOperand(std::forward<Rhs>(rhs));
+
+    return Binary<Operation, decltype(lhsOperand), decltype(rhsOperand)>(std::move(lhsOperand), std::move(rhsOperand));
+}
+
+template <typename T>
+auto makeScaled(T&& value, double factor)
+{
+    auto operand = makeOperand(std::forward<T>(value));
+    Scalar<ResultType<T>> scalar(factor, operand.getNumRows(), operand.getNumColumns());
+
+    return Binary<Multiply, decltype(operand), decltype(scalar)>(std::move(operand), scalar);
+}
+
+template <typename T>
+constexpr bool isExpiring = !std::is_lvalue_reference_v<T> && !std::is_const_v<std::remove_reference_t<T>>;
+
+// The destination already has the shape of the expression. Rows are evaluated independently, so the
+// destination may also appear as an operand.
+template <typename Destination, typename Expression>
+void evaluate(Destination& destination, const Expression& expression)
+{
+    size_t numRows = expression.getNumRows();
+    size_t numColumns = expression.getNumColumns();
+
+    if constexpr (std::is_same_v<typename Expression::Result, Vector>)
+    {
+        PROFILE_SCOPE("vector_expression");
+        PROFILE_FLOPS(static_cast<uint64_t>(numColumns) * Expression::NUM_OPERATIONS);
+        PROFILE_BYTES(static_cast<uint64_t>(numColumns) * (Expression::NUM_OPERANDS + 1) * sizeof(double));
+
+        double* output = destination.begin();
+        auto row = expression.getRow(0);
+        for (size_t index = 0; index < numColumns; ++index)
+            output[index] = row[index];
+    }
+    else
+    {
+        PROFILE_SCOPE("matrix_expression");
+        PROFILE_FLOPS(static_cast<uint64_t>(numRows) * numColumns * Expression::NUM_OPERATIONS);
+        PROFILE_BYTES(static_cast<uint64_t>(numRows) * numColumns * (Expression::NUM_OPERANDS + 1) * sizeof(double));
+
+        size_t grain = std::max<size_t>(ELEMENTS_PER_TASK / std::max<size_t>(numColumns, 1), 1);
+        parallelFor(0, numRows, grain, [&](size_t first, size_t last)
+        {
+            for (size_t rowIndex = first; rowIndex < last; ++rowIndex)
+            {
+                double* output = destination[rowIndex].begin();
+                auto row = expression.getRow(rowIndex);
+                for (size_t index = 0; index < numColumns; ++index)
+                    output[index] = row[index];
+            }
+        });
+    }
+}
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<expression::isOperand<Lhs> && expression::isOperand<Rhs>>>
+auto operator+(Lhs&& lhs, Rhs&& rhs)
+{
+    return expression::makeBinary<expression::Add>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<expression::isOperand<Lhs> && expression::isOperand<Rhs>>>
+auto operator-(Lhs&& lhs, Rhs&& rhs)
+{
+    return expression::makeBinary<expression::Subtract>(std::forward<Lhs>(lhs), std::forward<Rhs>(rhs));
+}
+
+template <typename T, typename = std::enable_if_t<expression::isOperand<T>>>
+auto operator*(T&& value, double factor)
+{
+    return expression::makeScaled(std::forward<T>(value), factor);
+}
+
+template <typename T, typename = std::enable_if_t<expression::isOperand<T>>>
+auto operator*(double factor, T&& value)
+{
+    return expression::makeScaled(std::forward<T>(value), factor);
+}
+
+#endif // EXPRESSION_H
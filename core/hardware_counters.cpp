@@ -0,0 +1,262 @@
+#include "hardware_counters.h"
+
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#endif
+
+namespace profiler
+{
+namespace
+{
+std::atomic<bool> enabled{ false };
+std::mutex errorMutex;
+std::string error;
+
+void setError(const std::string& message)
+{
+    std::lock_guard<std::mutex> lock(errorMutex);
+    error = message;
+}
+
+#ifdef __linux__
+struct EventDescription
+{
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr std::array<EventDescription, NUM_HARDWARE_EVENTS> EVENTS = { {
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+    { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    { PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16) },
+} };
+
+class CounterGroup
+{
+public:
+    CounterGroup()
+    {
+        descriptors.fill(-1);
+
+        for (size_t index = 0; index < NUM_HARDWARE_EVENTS; ++index)
+        {
+            perf_event_attr attributes;
+            std::memset(&attributes, 0, sizeof(attributes));
+            attributes.size = sizeof(attributes);
+            attributes.type = EVENTS[index].type;
+            attributes.config = EVENTS[index].config;
+            attributes.disabled = (leader < 0) ? 1 : 0;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            attributes.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_ID | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+            int descriptor = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, leader, 0));
+            if (descriptor < 0)
+            {
+                if (leader < 0)
+                    failure = std::strerror(errno);
+                continue;
+            }
+
+            if (leader < 0)
+                leader = descriptor;
+            descriptors[index] = descriptor;
+            ioctl(descriptor, PERF_EVENT_IOC_ID, &ids[index]);
+        }
+
+        if (leader >= 0)
+        {
+            ioctl(leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+    }
+
+    CounterGroup(const CounterGroup&) = delete;
+
+    ~CounterGroup()
+    {
+        for (int descriptor : descriptors)
+            if (descriptor >= 0)
+                close(descriptor);
+    }
+
+    CounterGroup& operator=(const CounterGroup&) = delete;
+
+    bool isOpen() const
+    {
+        return leader >= 0;
+    }
+
+    const std::string& getFailure() const
+    {
+        return failure;
+    }
+
+    bool read(HardwareCounters& counters) const
+    {
+        struct
+        {
+            uint64_t numEvents;
+            uint64_t timeEnabled;
+            uint64_t timeRunning;
+            struct
+            {
+                uint64_t value;
+                uint64_t id;
+            } events[NUM_HARDWARE_EVENTS];
+        } buffer;
+
+        if (!isOpen() || (::read(leader, &buffer, sizeof(buffer)) <= 0) || (buffer.timeRunning == 0))
+            return false;
+
+        double scale = static_cast<double>(buffer.timeEnabled) / static_cast<double>(buffer.timeRunning);
+
+        counters = HardwareCounters();
+        for (uint64_t event = 0; event < buffer.numEvents; ++event)
+            for (size_t index = 0; index < NUM_HARDWARE_EVENTS; ++index)
+                if ((descriptors[index] >= 0) && (ids[index] == buffer.events[event].id))
+                {
+                    counters.values[index] = static_cast<uint64_t>(static_cast<double>(buffer.events[event].value) * scale);
+                    counters.available[index] = true;
+                }
+
+        return true;
+    }
+
+private:
+    int leader = -1;
+    std::array<int, NUM_HARDWARE_EVENTS> descriptors;
+    std::array<uint64_t, NUM_HARDWARE_EVENTS> ids{};
+    std::string failure;
+};
+
+CounterGroup& getCounterGroup()
+{
+    thread_local CounterGroup group;
+    return group;
+}
+#endif
+}
+
+uint64_t HardwareCounters::get(HardwareEvent event) const
+{
+    return values[static_cast<size_t>(event)];
+}
+
+bool HardwareCounters::has(HardwareEvent event) const
+{
+    return available[static_cast<size_t>(event)];
+}
+
+bool HardwareCounters::empty() const
+{
+    for (bool isAvailable : available)
+        if (isAvailable)
+            return false;
+
+    return true;
+}
+
+double HardwareCounters::getInstructionsPerCycle() const
+{
+    if (!has(HardwareEvent::Cycles) || !has(HardwareEvent::Instructions) || (get(HardwareEvent::Cycles) == 0))
+        return 0.0;
+
+    return static_cast<double>(get(HardwareEvent::Instructions)) / static_cast<double>(get(HardwareEvent::Cycles));
+}
+
+void HardwareCounters::add(const HardwareCounters& other)
+{
+    for (size_t index = 0; index < NUM_HARDWARE_EVENTS; ++index)
+    {
+        values[index] += other.values[index];
+        available[index] = available[index] || other.available[index];
+    }
+}
+
+void HardwareCounters::accumulate(const HardwareCounters& begin, const HardwareCounters& end)
+{
+    for (size_t index = 0; index < NUM_HARDWARE_EVENTS; ++index)
+    {
+        if (!begin.available[index] || !end.available[index])
+            continue;
+
+        values[index] += (end.values[index] > begin.values[index]) ? end.values[index] - begin.values[index] : 0;
+        available[index] = true;
+    }
+}
+
+const char* getHardwareEventName(HardwareEvent event)
+{
+    switch (event)
+    {
+    case HardwareEvent::Cycles:
+        return "cycles";
+    case HardwareEvent::Instructions:
+        return "instructions";
+    case HardwareEvent::CacheReferences:
+        return "cache_references";
+    case HardwareEvent::CacheMisses:
+        return "cache_misses";
+    case HardwareEvent::TlbMisses:
+        return "tlb_misses";
+    }
+
+    return "";
+}
+
+bool enableHardwareCounters()
+{
+#ifdef __linux__
+    const CounterGroup& group = getCounterGroup();
+    if (!group.isOpen())
+    {
+        setError("perf_event_open failed: " + group.getFailure());
+        return false;
+    }
+
+    setError("");
+    enabled.store(true, std::memory_order_release);
+    return true;
+#else
+    setError("Hardware counters are only supported on Linux");
+    return false;
+#endif
+}
+
+void disableHardwareCounters()
+{
+    enabled.store(false, std::memory_order_release);
+}
+
+bool areHardwareCountersEnabled()
+{
+    return enabled.load(std::memory_order_acquire);
+}
+
+std::string getHardwareCountersError()
+{
+    std::lock_guard<std::mutex> lock(errorMutex);
+    return error;
+}
+
+bool readHardwareCounters(HardwareCounters& counters)
+{
+#ifdef __linux__
+    return areHardwareCountersEnabled() && getCounterGroup().read(counters);
+#else
+    (void)counters;
+    return false;
+#endif
+}
+}
@@ -0,0 +1,46 @@
+#ifndef HARDWARECOUNTERS_H
+#define HARDWARECOUNTERS_H
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace profiler
+{
+enum class HardwareEvent
+{
+    Cycles,
+    Instructions,
+    CacheReferences,
+    CacheMisses,
+    TlbMisses
+};
+
+constexpr size_t NUM_HARDWARE_EVENTS = 5;
+
+struct HardwareCounters
+{
+    uint64_t get(HardwareEvent event) const;
+    bool has(HardwareEvent event) const;
+    bool empty() const;
+    double getInstructionsPerCycle() const;
+
+    void add(const HardwareCounters& other);
+    void accumulate(const HardwareCounters& begin, const HardwareCounters& end);
+
+    std::array<uint64_t, NUM_HARDWARE_EVENTS> values{};
+    std::array<bool, NUM_HARDWARE_EVENTS> available{};
+};
+
+const char* getHardwareEventName(HardwareEvent event);
+
+bool enableHardwareCounters();
+void disableHardwareCounters();
+bool areHardwareCountersEnabled();
+std::string getHardwareCountersError();
+
+// Reads the counters of the calling thread, each thread opens its own perf events
+bool readHardwareCounters(HardwareCounters& counters);
+}
+
+#endif // HARDWARECOUNTERS_H
@@ -0,0 +1,175 @@
+#include "mapped_file.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+MappedFile::MappedFile(const std::string& filepath, MappingMode mode /*= MappingMode::ReadOnly*/)
+    : mode(mode)
+{
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        throw std::invalid_argument("Failed to open the file: " + filepath);
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || (fileSize.QuadPart == 0))
+    {
+        CloseHandle(file);
+        throw std::invalid_argument("Failed to map the file: " + filepath);
+    }
+
+    DWORD protection = (mode == MappingMode::CopyOnWrite) ? PAGE_WRITECOPY : PAGE_READONLY;
+    HANDLE mapping = CreateFileMappingA(file, nullptr, protection, 0, 0, nullptr);
+    if (!mapping)
+    {
+        CloseHandle(file);
+        throw std::invalid_argument("Failed to map the file: " + filepath);
+    }
+
+    DWORD access = (mode == MappingMode::CopyOnWrite) ? FILE_MAP_COPY : FILE_MAP_READ;
+    void* view = MapViewOfFile(mapping, access, 0, 0, 0);
+    if (!view)
+    {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        throw std::invalid_argument("Failed to map the file: " + filepath);
+    }
+
+    address = view;
+    length = static_cast<size_t>(fileSize.QuadPart);
+    fileHandle = file;
+    mappingHandle = mapping;
+}
+#else
+MappedFile::MappedFile(const std::string& filepath, MappingMode mode /*= MappingMode::ReadOnly*/)
+    : mode(mode)
+{
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::invalid_argument("Failed to open the file: " + filepath);
+
+    struct stat info;
+    if ((::fstat(fd, &info) != 0) || (info.st_size == 0))
+    {
+        ::close(fd);
+        throw std::invalid_argument("Failed to map the file: " + filepath);
+    }
+
+    int protection = (mode == MappingMode::CopyOnWrite) ? (PROT_READ | PROT_WRITE) : PROT_READ;
+    int flags = (mode == MappingMode::CopyOnWrite) ? MAP_PRIVATE : MAP_SHARED;
+    void* view = ::mmap(nullptr, static_cast<size_t>(info.st_size), protection, flags, fd, 0);
+    ::close(fd);
+
+    if (view == MAP_FAILED)
+        throw std::invalid_argument("Failed to map the file: " + filepath);
+
+    address = view;
+    length = static_cast<size_t>(info.st_size);
+}
+#endif
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+MappedFile::~MappedFile()
+{
+    unmap();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        unmap();
+
+        address = std::exchange(other.address, nullptr);
+        length = std::exchange(other.length, 0);
+        mode = other.mode;
+#ifdef _WIN32
+        fileHandle = std::exchange(other.fileHandle, nullptr);
+        mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+    }
+
+    return *this;
+}
+
+char* MappedFile::data()
+{
+    return static_cast<char*>(address);
+}
+
+const char* MappedFile::data() const
+{
+    return static_cast<const char*>(address);
+}
+
+size_t MappedFile::size() const
+{
+    return length;
+}
+
+bool MappedFile::isWritable() const
+{
+    return mode == MappingMode::CopyOnWrite;
+}
+
+void MappedFile::advise(AccessPattern pattern) const
+{
+    advise(address, length, pattern);
+}
+
+void MappedFile::advise(const void* start, size_t size, AccessPattern pattern) const
+{
+#ifdef _WIN32
+    (void)start;
+    (void)size;
+    (void)pattern;
+#else
+    if (!address || (size == 0))
+        return;
+
+    static const uintptr_t pageSize = static_cast<uintptr_t>(::sysconf(_SC_PAGESIZE));
+    uintptr_t begin = reinterpret_cast<uintptr_t>(start) & ~(pageSize - 1);
+    uintptr_t end = reinterpret_cast<uintptr_t>(start) + size;
+
+    int advice = MADV_NORMAL;
+    if (pattern == AccessPattern::Sequential)
+        advice = MADV_SEQUENTIAL;
+    else if (pattern == AccessPattern::Random)
+        advice = MADV_RANDOM;
+
+    ::madvise(reinterpret_cast<void*>(begin), end - begin, advice);
+#endif
+}
+
+void MappedFile::unmap()
+{
+    if (!address)
+        return;
+
+#ifdef _WIN32
+    UnmapViewOfFile(address);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    fileHandle = nullptr;
+    mappingHandle = nullptr;
+#else
+    ::munmap(address, length);
+#endif
+
+    address = nullptr;
+    length = 0;
+}
@@ -0,0 +1,51 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+
+enum class MappingMode
+{
+    ReadOnly,
+    CopyOnWrite
+};
+
+enum class AccessPattern
+{
+    Normal,
+    Sequential,
+    Random
+};
+
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& filepath, MappingMode mode = MappingMode::ReadOnly);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    char* data();
+    const char* data() const;
+    size_t size() const;
+    bool isWritable() const;
+
+    void advise(AccessPattern pattern) const;
+    void advise(const void* start, size_t size, AccessPattern pattern) const;
+
+private:
+    void unmap();
+
+    void* address = nullptr;
+    size_t length = 0;
+    MappingMode mode = MappingMode::ReadOnly;
+
+#ifdef _WIN32
+    void* fileHandle = nullptr;
+    void* mappingHandle = nullptr;
+#endif
+};
+
+#endif // MAPPEDFILE_H
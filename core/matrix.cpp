@@ -0,0 +1,637 @@
+#include "matrix.h"
+
+#include "vector.h"
+#include "profiler.h"
+#include "mapped_file.h"
+#include "numa.h"
+#include "solver_workspace.h"
+#include "row_stream.h"
+#include "reduction.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <fstream>
+#include <stdexcept>
+#include <filesystem>
+
+namespace
+{
+constexpr size_t ELEMENTS_PER_TASK = 1 << 14;
+constexpr size_t GEMM_DEPTH_BLOCK = 128;
+constexpr size_t GEMM_COLUMN_BLOCK = 512;
+
+size_t getRowGrain(size_t costPerRow)
+{
+    return std::max<size_t>(ELEMENTS_PER_TASK / std::max<size_t>(costPerRow, 1), 1);
+}
+
+Vector readMatrixRow(const std::string& line)
+{
+    Vector values;
+
+    std::istringstream ss(line);
+    double num = 0.0;
+    while (ss >> num)
+        values.pushBack(num);
+
+    return values;
+}
+}
+
+Matrix::Matrix(int numRows, int numCols, int value)
+{
+    if ((numRows <= 0) || (numCols <= 0))
+        throw std::invalid_argument("Invalid size of matrix");
+
+    data = std::vector<Vector>(numRows);
+
+    auto initializeRows = [&](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            data[i] = Vector(numCols, 0.0);
+            if (i < static_cast<size_t>(numCols))
+                data[i][i] = value;
+        }
+    };
+
+    if (numa::getMemoryPlacement() == numa::MemoryPlacement::Interleaved)
+    {
+        numa::ScopedInterleave interleave;
+        initializeRows(0, numRows);
+    }
+    else
+    {
+        parallelFor(0, numRows, getRowGrain(numCols), initializeRows);
+    }
+}
+
+Matrix& Matrix::operator*=(double factor)
+{
+    return *this = *this * factor;
+}
+
+Vector& Matrix::operator[](size_t index)
+{
+    if (index >= data.size())
+        throw std::out_of_range("Matrix index is out of range");
+
+    return data[index];
+}
+
+const Vector& Matrix::operator[](size_t index) const
+{
+    if (index >= data.size())
+        throw std::out_of_range("Matrix index is out of range");
+
+    return data[index];
+}
+
+double& Matrix::at(size_t rowIndex, size_t columnIndex)
+{
+    if (rowIndex >= data.size())
+        throw std::out_of_range("Matrix index is out of range");
+
+    return data[rowIndex][columnIndex];
+}
+
+double Matrix::at(size_t rowIndex, size_t columnIndex) const
+{
+    if (rowIndex >= data.size())
+        throw std::out_of_range("Matrix index is out of range");
+
+    return data[rowIndex][columnIndex];
+}
+
+size_t Matrix::getNumRows() const
+{
+    return data.size();
+}
+
+size_t Matrix::getNumColumns() const
+{
+    return data.front().size();
+}
+
+void Matrix::addRow(size_t index, double value /*= 0.0*/)
+{
+    checkRowIndex(index);
+
+    size_t colsNumber = this->data.front().size();
+    auto it = data.cbegin()+index;
+    this->data.insert(it, Vector(colsNumber, value));
+}
+
+void Matrix::addColumn(size_t index, double value /*= 0.0*/)
+{
+    checkColumnIndex(index);
+
+    for (auto& row : this->data)
+        row.insert(index, value);
+}
+
+void Matrix::removeRow(size_t index)
+{
+    checkRowIndex(index);
+
+    auto it = data.cbegin() + index;
+    data.erase(it);
+}
+
+void Matrix::removeColumn(size_t index)
+{
+    checkColumnIndex(index);
+
+    for (auto& row : data)
+        row.remove(index);
+}
+
+void Matrix::reset(int numRows, int numColumns)
+{
+    if ((numRows <= 0) || (numColumns <= 0))
+        throw std::invalid_argument("Invalid size of matrix");
+
+    if ((getNumRows() == static_cast<size_t>(numRows)) && (getNumColumns() == static_cast<size_t>(numColumns)))
+    {
+        for (Vector& row : data)
+            std::fill(row.begin(), row.end(), 0.0);
+        return;
+    }
+
+    this->data = std::vector<Vector>(numRows, Vector(numColumns, 0.0));
+}
+
+void Matrix::randomize(double leftBorder, double rightBorder)
+{
+    std::random_device rd;
+    std::mt19937 gen(rd());
+    std::uniform_real_distribution<> dis(leftBorder, rightBorder);
+
+    for (size_t rowIndex = 0; rowIndex < getNumRows(); ++rowIndex)
+    {
+        for (size_t columnIndex = 0; columnIndex < getNumColumns(); ++columnIndex)
+        {
+            double randomValue = dis(gen);
+            data[rowIndex][columnIndex] = static_cast<double>(std::round(randomValue * 100)) / 100;
+        }
+    }
+}
+
+void Matrix::caclulateLUDecomposition(Matrix& L, Matrix& U) const
+{
+    PROFILE_SCOPE("lu_decomposition");
+
+    int size = getNumRows();
+    adviseAccess(AccessPattern::Random);
+
+    [[maybe_unused]] uint64_t n = size;
+    PROFILE_FLOPS(2 * n * n * n / 3);
+    PROFILE_BYTES(2 * n * n * n / 3 * sizeof(double));
+
+    L.reset(size, size);
+    U.reset(size, size);
+
+    for (int j = 0; j < size; j++)
+    {
+        for (int i = 0; i < size; i++)
+        {
+            if (i <= j)
+            {
+                double sum = 0.0;
+                for (int k = 0; k < i; k++)
+                    sum += L[i][k] * U[k][j];
+
+                U[i][j] = data[i][j] - sum;
+            }
+
+            if (i >= j)
+            {
+                if (j == 0)
+                {
+                    L[i][j] = data[i][j] / U[j][j];
+                }
+                else
+                {
+                    double sum = 0.0;
+                    for (int k = 0; k < j; k++)
+                        sum += L[i][k] * U[k][j];
+
+                    L[i][j] = (data[i][j] - sum) / U[j][j];
+                }
+            }
+        }
+    }
+}
+
+Matrix Matrix::calculateInverse() const
+{
+    Matrix inverse;
+    SolverWorkspace workspace;
+    calculateInverse(inverse, workspace);
+    return inverse;
+}
+
+void Matrix::calculateInverse(Matrix& inverse, SolverWorkspace& workspace) const
+{
+    PROFILE_SCOPE("inverse");
+
+    int size = getNumRows();
+
+    Matrix& L = workspace.getMatrix(WorkspaceSlot::Lower, size, size);
+    Matrix& U = workspace.getMatrix(WorkspaceSlot::Upper, size, size);
+    caclulateLUDecomposition(L, U);
+
+    [[maybe_unused]] uint64_t n = size;
+    PROFILE_FLOPS(4 * n * n * n);
+    PROFILE_BYTES(4 * n * n * n * sizeof(double));
+
+    Matrix& Z = workspace.getMatrix(WorkspaceSlot::ForwardSubstitution, size, size);
+    inverse.reset(size, size);
+
+    for (int col = 0; col < size; col++)
+    {
+        for (int row = 0; row < size; row++)
+        {
+            double sum = 0;
+            for (int i = 0; i < size; i++)
+                if (i != row)
+                    sum += L[row][i] * Z[i][col];
+
+            double result = ((row == col) ? 1.0 : 0.0) - sum;
+            Z[row][col] = result / L[row][row];
+        }
+    }
+
+    for (int col = 0; col < size; col++) {
+        for (int row = size - 1; row >= 0; row--) {
+            double sum = 0;
+            for (int i = 0; i < size; i++) {
+                if (i != row) {
+                    sum += U[row][i] * inverse[i][col];
+                }
+            }
+
+            double result = Z[row][col] - sum;
+            inverse[row][col] = result / U[row][row];
+        }
+    }
+}
+
+double Matrix::calculateEuclidianNorm() const
+{
+    PROFILE_SCOPE("norm");
+    PROFILE_FLOPS(2 * static_cast<uint64_t>(getNumRows()) * getNumColumns() + 1);
+    PROFILE_BYTES(static_cast<uint64_t>(getNumRows()) * getNumColumns() * sizeof(double));
+
+    double norm = parallelSum(0, getNumRows(), getRowGrain(getNumColumns()), [this](size_t first, size_t last)
+    {
+        double sum = 0.0;
+        for (size_t i = first; i < last; i++)
+            for (double value : data[i])
+                sum += value * value;
+
+        return sum;
+    });
+
+    return std::sqrt(norm);
+}
+
+bool Matrix::isMapped() const
+{
+    for (const auto& row : data)
+        if (row.isMapped())
+            return true;
+
+    return false;
+}
+
+void Matrix::adviseAccess(AccessPattern pattern) const
+{
+    const MappedFile* mapping = nullptr;
+    const double* begin = nullptr;
+    const double* end = nullptr;
+
+    for (const auto& row : data)
+    {
+        if (row.mapping && (row.mapping.get() == mapping) && (row.begin() == end))
+        {
+            end = row.end();
+            continue;
+        }
+
+        if (mapping)
+            mapping->advise(begin, (end - begin) * sizeof(double), pattern);
+
+        mapping = row.mapping.get();
+        begin = row.begin();
+        end = row.end();
+    }
+
+    if (mapping)
+        mapping->advise(begin, (end - begin) * sizeof(double), pattern);
+}
+
+Matrix Matrix::mapFromFile(const std::string& filename, MappingMode mode /*= MappingMode::ReadOnly*/)
+{
+    auto file = std::make_shared<MappedFile>(filename, mode);
+    npy::Header header = npy::parseHeader(file->data(), file->size());
+
+    size_t numRows = header.shape.empty() ? 0 : header.shape[0];
+    size_t numColumns = (header.shape.size() == 2) ? header.shape[1] : 1;
+
+    bool isRowMajor = (header.order == npy::Order::C) || (numColumns == 1);
+    bool isAligned = (header.dataOffset % alignof(double)) == 0;
+    bool isNative = (header.type == npy::DataType::Float64) && !header.swapBytes;
+    if ((header.shape.size() > 2) || !isRowMajor || !isAligned || !isNative)
+        return fromNpyArray(file->data(), file->size());
+
+    if ((numRows == 0) || (numColumns == 0))
+        throw std::invalid_argument("Invalid size of matrix");
+
+    double* values = reinterpret_cast<double*>(file->data() + header.dataOffset);
+
+    Matrix matrix;
+    matrix.data.reserve(numRows);
+    for (size_t rowIndex = 0; rowIndex < numRows; ++rowIndex)
+        matrix.data.push_back(Vector(file, values + rowIndex * numColumns, numColumns));
+
+    return matrix;
+}
+
+Matrix Matrix::readFromFile(const std::string& filename)
+{
+    PROFILE_SCOPE("read_matrix");
+
+    if (std::filesystem::path(filename).extension() == ".npy")
+        return readFromNpy(filename);
+
+    if (std::filesystem::path(filename).extension() == ".mtx")
+        return readFromStream(*MatrixRowStream::open(filename));
+
+    Matrix matrix;
+
+    if (!std::filesystem::exists(filename))
+        throw std::invalid_argument("Failed to open the file: " + filename);
+
+    std::ifstream file(filename);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to open the file: " + filename);
+
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(file, line);)
+        if (!line.empty())
+            lines.push_back(std::move(line));
+
+    matrix.data.resize(lines.size());
+    parallelFor(0, lines.size(), getRowGrain(lines.empty() ? 1 : lines.front().size()), [&](size_t first, size_t last)
+    {
+        for (size_t index = first; index < last; ++index)
+            matrix.data[index] = readMatrixRow(lines[index]);
+    });
+
+    return matrix;
+}
+
+void Matrix::writeToFile(const Matrix &matrix, const std::string& filename)
+{
+    PROFILE_SCOPE("write_matrix");
+
+    if (std::filesystem::path(filename).extension() == ".npy")
+    {
+        writeToNpy(matrix, filename);
+        return;
+    }
+
+    std::ofstream file(filename, std::ios_base::app);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to create a file: " + filename);
+
+    for (const auto& row : matrix.data)
+    {
+        for (size_t index = 0; index < row.size(); ++index)
+        {
+            file << row[index];
+            if (index != (row.size() - 1))
+                file << ' ';
+        }
+        file << std::endl;
+    }
+}
+
+Matrix Matrix::readFromStream(MatrixRowStream& stream)
+{
+    Matrix matrix;
+
+    std::vector<double> row;
+    while (stream.readRow(row))
+    {
+        matrix.data.emplace_back(static_cast<int>(row.size()));
+        std::copy(row.begin(), row.end(), matrix.data.back().begin());
+    }
+
+    return matrix;
+}
+
+Matrix Matrix::readFromNpy(const std::string& filename)
+{
+    MappedFile file(filename);
+    return fromNpyArray(file.data(), file.size());
+}
+
+void Matrix::writeToNpy(const Matrix& matrix, const std::string& filename, npy::DataType type /*= npy::DataType::Float64*/, npy::Order order /*= npy::Order::C*/)
+{
+    std::ofstream file(filename, std::ios_base::binary | std::ios_base::trunc);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to create a file: " + filename);
+
+    writeNpyArray(matrix, file, type, order);
+}
+
+std::map<std::string, Matrix> Matrix::readFromNpz(const std::string& filename)
+{
+    MappedFile file(filename);
+
+    std::map<std::string, Matrix> matrices;
+    for (const auto& entry : npy::readArchiveDirectory(file.data(), file.size()))
+    {
+        std::string name = entry.name;
+        if (std::filesystem::path(name).extension() == ".npy")
+            name.erase(name.size() - 4);
+
+        matrices[name] = fromNpyArray(file.data() + entry.offset, entry.size);
+    }
+
+    return matrices;
+}
+
+void Matrix::writeToNpz(const std::map<std::string, Matrix>& matrices, const std::string& filename, npy::DataType type /*= npy::DataType::Float64*/)
+{
+    npy::ArchiveWriter archive(filename);
+
+    for (const auto& [name, matrix] : matrices)
+        writeNpyArray(matrix, archive.beginEntry(name + ".npy"), type, npy::Order::C);
+
+    archive.close();
+}
+
+Matrix Matrix::fromNpyArray(const char* data, size_t size)
+{
+    PROFILE_SCOPE("parse_npy");
+    npy::Header header = npy::parseHeader(data, size);
+
+    size_t numRows = 0;
+    size_t numColumns = 0;
+    if (header.shape.size() == 2)
+    {
+        numRows = header.shape[0];
+        numColumns = header.shape[1];
+    }
+    else if (header.shape.size() == 1)
+    {
+        numRows = header.shape[0];
+        numColumns = 1;
+    }
+    else
+    {
+        throw std::invalid_argument("Only 1-D and 2-D arrays can be loaded as a matrix");
+    }
+
+    Matrix matrix(static_cast<int>(numRows), static_cast<int>(numColumns));
+    const char* values = data + header.dataOffset;
+
+    if (header.order == npy::Order::C)
+    {
+        for (size_t rowIndex = 0; rowIndex < numRows; ++rowIndex)
+            npy::readValues(values + rowIndex * numColumns * header.itemSize(), header, numColumns, matrix.data[rowIndex].begin());
+    }
+    else
+    {
+        Vector column(static_cast<int>(numRows));
+        for (size_t columnIndex = 0; columnIndex < numColumns; ++columnIndex)
+        {
+            npy::readValues(values + columnIndex * numRows * header.itemSize(), header, numRows, column.begin());
+            for (size_t rowIndex = 0; rowIndex < numRows; ++rowIndex)
+                matrix.data[rowIndex][columnIndex] = column[rowIndex];
+        }
+    }
+
+    return matrix;
+}
+
+void Matrix::writeNpyArray(const Matrix& matrix, std::ostream& output, npy::DataType type, npy::Order order)
+{
+    size_t numRows = matrix.getNumRows();
+    size_t numColumns = (numRows > 0) ? matrix.getNumColumns() : 0;
+
+    npy::writeHeader(output, type, order, { numRows, numColumns });
+
+    if (order == npy::Order::C)
+    {
+        for (const auto& row : matrix.data)
+            npy::writeValues(output, row.begin(), row.size(), type);
+    }
+    else
+    {
+        std::vector<double> column(numRows);
+        for (size_t columnIndex = 0; columnIndex < numColumns; ++columnIndex)
+        {
+            for (size_t rowIndex = 0; rowIndex < numRows; ++rowIndex)
+                column[rowIndex] = matrix.data[rowIndex][columnIndex];
+
+            npy::writeValues(output, column.data(), numRows, type);
+        }
+    }
+
+    if (!output)
+        throw std::runtime_error("Failed to write the .npy data");
+}
+
+Matrix operator*(const Matrix& lhs, const Matrix& rhs)
+{
+    if (lhs.getNumColumns() != rhs.getNumRows())
+        throw std::invalid_argument("Can't multiply matrices with given sizes");
+
+    PROFILE_SCOPE("matrix_multiply");
+    PROFILE_FLOPS(2 * static_cast<uint64_t>(lhs.getNumRows()) * rhs.getNumColumns() * lhs.getNumColumns());
+    PROFILE_BYTES(3 * static_cast<uint64_t>(lhs.getNumRows()) * rhs.getNumColumns() * lhs.getNumColumns() * sizeof(double));
+
+    Matrix result(lhs.getNumRows(), rhs.getNumColumns());
+
+    size_t depth = lhs.getNumColumns();
+    size_t numColumns = rhs.getNumColumns();
+
+    // Row panels are independent, and every element still sums over k in ascending order, so the result does not depend on the thread count.
+    parallelFor(0, lhs.getNumRows(), getRowGrain(depth * numColumns), [&](size_t first, size_t last)
+    {
+        for (size_t firstK = 0; firstK < depth; firstK += GEMM_DEPTH_BLOCK)
+        {
+            size_t lastK = std::min(depth, firstK + GEMM_DEPTH_BLOCK);
+
+            for (size_t firstColumn = 0; firstColumn < numColumns; firstColumn += GEMM_COLUMN_BLOCK)
+            {
+                size_t lastColumn = std::min(numColumns, firstColumn + GEMM_COLUMN_BLOCK);
+
+                for (size_t rowIndex = first; rowIndex < last; ++rowIndex)
+                {
+                    double* output = result[rowIndex].begin();
+                    const double* lhsRow = lhs[rowIndex].begin();
+
+                    for (size_t k = firstK; k < lastK; ++k)
+                    {
+                        double value = lhsRow[k];
+                        const double* rhsRow = rhs[k].begin();
+                        for (size_t colIndex = firstColumn; colIndex < lastColumn; ++colIndex)
+                            output[colIndex] += value * rhsRow[colIndex];
+                    }
+                }
+            }
+        }
+    });
+
+    return result;
+}
+
+std::ostream& operator<<(std::ostream& output, const Matrix& matrix)
+{
+    for (const auto& row : matrix.data)
+    {
+        for (size_t index = 0; index < row.size(); ++index)
+        {
+            output << row[index];
+            if (index != (row.size() - 1))
+                output << ' ';
+        }
+        output << std::endl;
+    }
+
+    return output;
+}
+
+std::istream& operator>>(std::istream& input, Matrix& matrix)
+{
+    std::string line;
+    while(std::getline(input, line))
+        if (!line.empty())
+            matrix.data.push_back(readMatrixRow(line));
+
+    return input;
+}
+
+void Matrix::checkIndex(int rowIndex, int columnIndex) const
+{
+    if (!checkRowIndex(rowIndex) || !checkColumnIndex(columnIndex))
+        throw std::out_of_range("Invalid index of the matrix element: [" + std::to_string(rowIndex) + ", " + std::to_string(columnIndex) + ']');
+}
+
+bool Matrix::checkRowIndex(int index) const
+{
+    return (index >= 0) && (index < this->data.size());
+}
+
+bool Matrix::checkColumnIndex(int index) const
+{
+    return (index >= 0) && (index < this->data.front().size());
+}
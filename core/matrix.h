@@ -0,0 +1,167 @@
+#ifndef MATRIX_H
+#define MATRIX_H
+
+#include "vector.h"
+#include "npy.h"
+#include "expression.h"
+
+#include <vector>
+#include <string>
+#include <map>
+
+class MatrixRowStream;
+class SolverWorkspace;
+
+using matrix_t = std::vector<Vector>;
+
+class Matrix
+{
+public:
+    Matrix() = default;
+    Matrix(int numRows, int numCols, int value = 0.0);
+    Matrix(const Matrix&) = default;
+    Matrix(Matrix&&) = default;
+
+    template <typename Expression, typename = std::enable_if_t<expression::isExpression<Expression> && std::is_same_v<expression::ResultType<Expression>, Matrix>>>
+    Matrix(Expression&& expression);
+
+    Matrix& operator=(const Matrix&) = default;
+    Matrix& operator=(Matrix&&) = default;
+
+    template <typename Expression, typename = std::enable_if_t<expression::isExpression<Expression> && std::is_same_v<expression::ResultType<Expression>, Matrix>>>
+    Matrix& operator=(Expression&& expression);
+
+    template <typename T, typename = std::enable_if_t<std::is_same_v<expression::ResultType<T>, Matrix>>>
+    Matrix& operator+=(T&& other);
+    template <typename T, typename = std::enable_if_t<std::is_same_v<expression::ResultType<T>, Matrix>>>
+    Matrix& operator-=(T&& other);
+    Matrix& operator*=(double factor);
+
+    template <typename T, typename = std::enable_if_t<std::is_same_v<expression::ResultType<T>, Matrix>>>
+    Matrix& addScaled(T&& other, double factor);
+    Vector& operator[](size_t index);
+    const Vector& operator[](size_t index) const;
+
+    double& at(size_t rowIndex, size_t columnIndex);
+    double at(size_t rowIndex, size_t columnIndex) const;
+
+    size_t getNumRows() const;
+    size_t getNumColumns() const;
+
+    void addRow(size_t index, double value = 0.0);
+    void addColumn(size_t index, double value = 0.0);
+    void removeRow(size_t index);
+    void removeColumn(size_t index);
+
+    void reset(int numRows, int numColumns);
+    void randomize(double leftBorder, double rightBorder);
+
+    void caclulateLUDecomposition(Matrix& L, Matrix& U) const;
+    Matrix calculateInverse() const;
+    void calculateInverse(Matrix& inverse, SolverWorkspace& workspace) const;
+
+    double calculateEuclidianNorm() const;
+
+    bool isMapped() const;
+    void adviseAccess(AccessPattern pattern) const;
+
+    static Matrix mapFromFile(const std::string& filename, MappingMode mode = MappingMode::ReadOnly);
+    static Matrix readFromFile(const std::string& filename);
+    static void writeToFile(const Matrix& matrix, const std::string& filename);
+    static Matrix readFromStream(MatrixRowStream& stream);
+    static Matrix readFromNpy(const std::string& filename);
+    static void writeToNpy(const Matrix& matrix, const std::string& filename, npy::DataType type = npy::DataType::Float64, npy::Order order = npy::Order::C);
+    static std::map<std::string, Matrix> readFromNpz(const std::string& filename);
+    static void writeToNpz(const std::map<std::string, Matrix>& matrices, const std::string& filename, npy::DataType type = npy::DataType::Float64);
+
+    friend Matrix operator*(const Matrix& lhs, const Matrix& rhs);
+    friend std::ostream& operator<<(std::ostream& output, const Matrix& matrix);
+    friend std::istream& operator>>(std::istream& output, Matrix& matrix);
+
+private:
+    static Matrix fromNpyArray(const char* data, size_t size);
+    static void writeNpyArray(const Matrix& matrix, std::ostream& output, npy::DataType type, npy::Order order);
+
+    void checkIndex(int rowIndex, int columnIndex) const;
+    bool checkRowIndex(int index) const;
+    bool checkColumnIndex(int index) const;
+
+    matrix_t data;
+};
+
+template <typename Expression, typename>
+Matrix::Matrix(Expression&& expression)
+{
+    *this = std::forward<Expression>(expression);
+}
+
+// A new shape is first looked for among the temporaries owned by the expression, and only then allocated
+template <typename Expression, typename>
+Matrix& Matrix::operator=(Expression&& expression)
+{
+    size_t numRows = expression.getNumRows();
+    size_t numColumns = expression.getNumColumns();
+    if ((getNumRows() == numRows) && (getNumColumns() == numColumns))
+    {
+        expression::evaluate(*this, expression);
+        return *this;
+    }
+
+    Matrix* storage = nullptr;
+    if constexpr (expression::isExpiring<Expression>)
+        storage = expression.getReusableStorage();
+
+    if (!storage)
+    {
+        *this = Matrix(static_cast<int>(numRows), static_cast<int>(numColumns));
+        expression::evaluate(*this, expression);
+        return *this;
+    }
+
+    expression::evaluate(*storage, expression);
+    *this = std::move(*storage);
+    return *this;
+}
+
+template <typename T, typename>
+Matrix& Matrix::operator+=(T&& other)
+{
+    return *this = *this + std::forward<T>(other);
+}
+
+template <typename T, typename>
+Matrix& Matrix::operator-=(T&& other)
+{
+    return *this = *this - std::forward<T>(other);
+}
+
+template <typename T, typename>
+Matrix& Matrix::addScaled(T&& other, double factor)
+{
+    return *this = *this + std::forward<T>(other) * factor;
+}
+
+namespace expression
+{
+inline const Matrix& materialize(const Matrix& matrix)
+{
+    return matrix;
+}
+
+template <typename Expression, typename = std::enable_if_t<isExpression<Expression>>>
+Matrix materialize(Expression&& expression)
+{
+    return Matrix(std::forward<Expression>(expression));
+}
+}
+
+// Products are never fused into an element-wise loop, operands that are expressions are evaluated
+// first and multiplied with the blocked kernel
+template <typename Lhs, typename Rhs, typename = std::enable_if_t<(expression::isExpression<Lhs> || expression::isExpression<Rhs>)
+    && std::is_same_v<expression::ResultType<Lhs>, Matrix> && std::is_same_v<expression::ResultType<Rhs>, Matrix>>>
+Matrix operator*(Lhs&& lhs, Rhs&& rhs)
+{
+    return expression::materialize(std::forward<Lhs>(lhs)) * expression::materialize(std::forward<Rhs>(rhs));
+}
+
+#endif // MATRIX_H
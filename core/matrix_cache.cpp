@@ -0,0 +1,287 @@
+#include "matrix_cache.h"
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+constexpr const char* CACHE_NAME = "computational_linear_algebra";
+constexpr const char* ENTRY_EXTENSION = ".npy";
+constexpr size_t NUM_SAMPLES = 16;
+constexpr size_t SAMPLE_SIZE = 4096;
+
+constexpr uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ull;
+constexpr uint64_t FNV_PRIME = 0x100000001b3ull;
+
+uint64_t hashBytes(const char* data, size_t size, uint64_t hash = FNV_OFFSET_BASIS)
+{
+    for (size_t index = 0; index < size; ++index)
+    {
+        hash ^= static_cast<unsigned char>(data[index]);
+        hash *= FNV_PRIME;
+    }
+
+    return hash;
+}
+
+uint64_t hashValue(uint64_t value, uint64_t hash)
+{
+    char bytes[sizeof(value)];
+    for (size_t index = 0; index < sizeof(value); ++index)
+        bytes[index] = static_cast<char>(value >> (8 * index));
+
+    return hashBytes(bytes, sizeof(bytes), hash);
+}
+
+uint64_t calculateFingerprint(const std::filesystem::path& filepath, uint64_t fileSize)
+{
+    std::ifstream file(filepath, std::ios_base::binary);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to open the file: " + filepath.string());
+
+    uint64_t hash = FNV_OFFSET_BASIS;
+    std::array<char, SAMPLE_SIZE> buffer;
+
+    for (size_t sample = 0; sample <= NUM_SAMPLES; ++sample)
+    {
+        uint64_t offset = (fileSize > SAMPLE_SIZE) ? (fileSize - SAMPLE_SIZE) / NUM_SAMPLES * sample : 0;
+
+        file.seekg(static_cast<std::streamoff>(offset));
+        file.read(buffer.data(), buffer.size());
+        hash = hashBytes(buffer.data(), static_cast<size_t>(file.gcount()), hash);
+        file.clear();
+    }
+
+    return hash;
+}
+
+std::filesystem::path getUserCacheDirectory()
+{
+#ifdef _WIN32
+    const char* localAppData = std::getenv("LOCALAPPDATA");
+    if (localAppData && *localAppData)
+        return std::filesystem::path(localAppData) / CACHE_NAME;
+
+    return std::filesystem::temp_directory_path() / CACHE_NAME;
+#else
+    const char* cacheHome = std::getenv("XDG_CACHE_HOME");
+    if (cacheHome && (cacheHome[0] == '/'))
+        return std::filesystem::path(cacheHome) / CACHE_NAME;
+
+    const char* home = std::getenv("HOME");
+    if (home && (home[0] == '/'))
+        return std::filesystem::path(home) / ".cache" / CACHE_NAME;
+
+    return std::filesystem::temp_directory_path() / (std::string(CACHE_NAME) + "-" + std::to_string(::geteuid()));
+#endif
+}
+
+// Entries are only trusted in a directory that nobody but the current user can write to
+bool prepareDirectory(const std::filesystem::path& directory)
+{
+    std::error_code error;
+
+#ifdef _WIN32
+    std::filesystem::create_directories(directory, error);
+    return std::filesystem::is_directory(directory, error);
+#else
+    std::filesystem::create_directories(directory.parent_path(), error);
+    if ((::mkdir(directory.c_str(), 0700) != 0) && (errno != EEXIST))
+        return false;
+
+    struct stat status;
+    if ((::lstat(directory.c_str(), &status) != 0) || !S_ISDIR(status.st_mode))
+        return false;
+
+    return (status.st_uid == ::geteuid()) && ((status.st_mode & (S_IWGRP | S_IWOTH)) == 0);
+#endif
+}
+}
+
+MatrixCache::MatrixCache(const std::filesystem::path& directory, uint64_t sizeLimit /*= DEFAULT_SIZE_LIMIT*/)
+    : directory(directory)
+    , sizeLimit(sizeLimit)
+{
+}
+
+MatrixCache& MatrixCache::instance()
+{
+    static MatrixCache cache(getUserCacheDirectory());
+    return cache;
+}
+
+const std::filesystem::path& MatrixCache::getDirectory() const
+{
+    return directory;
+}
+
+uint64_t MatrixCache::getSizeLimit() const
+{
+    return sizeLimit;
+}
+
+uint64_t MatrixCache::getSize() const
+{
+    uint64_t size = 0;
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if (entry.path().extension() != ENTRY_EXTENSION)
+            continue;
+
+        uint64_t entrySize = entry.file_size(error);
+        if (!error)
+            size += entrySize;
+    }
+
+    return size;
+}
+
+Matrix MatrixCache::load(const std::string& filepath)
+{
+    if (!std::filesystem::exists(filepath))
+        throw std::invalid_argument("Failed to open the file: " + filepath);
+
+    if ((std::filesystem::path(filepath).extension() == ".npy") || (std::filesystem::file_size(filepath) == 0))
+        return Matrix::readFromFile(filepath);
+
+    if (!prepareDirectory(directory))
+        return Matrix::readFromFile(filepath);
+
+    std::filesystem::path entryPath = getEntryPath(filepath);
+
+    std::error_code error;
+    if (std::filesystem::exists(entryPath, error))
+    {
+        try
+        {
+            Matrix matrix = Matrix::mapFromFile(entryPath.string());
+            std::filesystem::last_write_time(entryPath, std::filesystem::file_time_type::clock::now(), error);
+            return matrix;
+        }
+        catch (const std::exception&)
+        {
+            std::filesystem::remove(entryPath, error);
+        }
+    }
+
+    Matrix matrix = Matrix::readFromFile(filepath);
+
+    try
+    {
+        store(matrix, entryPath);
+    }
+    catch (const std::exception&)
+    {
+    }
+
+    return matrix;
+}
+
+void MatrixCache::clear()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!prepareDirectory(directory))
+        return;
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+        if (entry.path().extension() == ENTRY_EXTENSION)
+            std::filesystem::remove(entry.path(), error);
+}
+
+std::filesystem::path MatrixCache::getEntryPath(const std::filesystem::path& filepath) const
+{
+    std::filesystem::path absolutePath = std::filesystem::weakly_canonical(filepath);
+    uint64_t fileSize = std::filesystem::file_size(absolutePath);
+    auto modificationTime = std::filesystem::last_write_time(absolutePath).time_since_epoch().count();
+
+    std::string pathString = absolutePath.string();
+    uint64_t pathHash = hashBytes(pathString.data(), pathString.size());
+
+    uint64_t contentHash = hashValue(fileSize, FNV_OFFSET_BASIS);
+    contentHash = hashValue(static_cast<uint64_t>(modificationTime), contentHash);
+    contentHash = hashValue(calculateFingerprint(absolutePath, fileSize), contentHash);
+
+    std::ostringstream name;
+    name << std::hex << std::setfill('0') << std::setw(16) << pathHash << '-' << std::setw(16) << contentHash << ENTRY_EXTENSION;
+
+    return directory / name.str();
+}
+
+void MatrixCache::store(const Matrix& matrix, const std::filesystem::path& entryPath)
+{
+    uint64_t entrySize = matrix.getNumRows() * matrix.getNumColumns() * sizeof(double);
+    if (entrySize > sizeLimit)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    evict(entrySize);
+
+    std::filesystem::path temporaryPath = entryPath;
+    temporaryPath += ".tmp";
+
+    try
+    {
+        Matrix::writeToNpy(matrix, temporaryPath.string());
+        std::filesystem::rename(temporaryPath, entryPath);
+    }
+    catch (...)
+    {
+        std::error_code error;
+        std::filesystem::remove(temporaryPath, error);
+        throw;
+    }
+}
+
+void MatrixCache::evict(uint64_t requiredSize)
+{
+    struct Entry
+    {
+        std::filesystem::path path;
+        uint64_t size;
+        std::filesystem::file_time_type lastUsed;
+    };
+
+    std::vector<Entry> entries;
+    uint64_t totalSize = 0;
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error))
+    {
+        if (entry.path().extension() != ENTRY_EXTENSION)
+            continue;
+
+        uint64_t size = entry.file_size(error);
+        if (error)
+            continue;
+
+        entries.push_back({ entry.path(), size, entry.last_write_time(error) });
+        totalSize += size;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.lastUsed < rhs.lastUsed; });
+
+    for (const auto& entry : entries)
+    {
+        if (totalSize + requiredSize <= sizeLimit)
+            break;
+
+        if (std::filesystem::remove(entry.path, error))
+            totalSize -= entry.size;
+    }
+}
@@ -0,0 +1,38 @@
+#ifndef MATRIXCACHE_H
+#define MATRIXCACHE_H
+
+#include "matrix.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+
+class MatrixCache
+{
+public:
+    static constexpr uint64_t DEFAULT_SIZE_LIMIT = uint64_t(2) << 30;
+
+    explicit MatrixCache(const std::filesystem::path& directory, uint64_t sizeLimit = DEFAULT_SIZE_LIMIT);
+
+    // Kept under $XDG_CACHE_HOME or ~/.cache, the directory is created for the current user only
+    static MatrixCache& instance();
+
+    const std::filesystem::path& getDirectory() const;
+    uint64_t getSizeLimit() const;
+    uint64_t getSize() const;
+
+    Matrix load(const std::string& filepath);
+    void clear();
+
+private:
+    std::filesystem::path getEntryPath(const std::filesystem::path& filepath) const;
+    void store(const Matrix& matrix, const std::filesystem::path& entryPath);
+    void evict(uint64_t requiredSize);
+
+    std::filesystem::path directory;
+    uint64_t sizeLimit = 0;
+    std::mutex mutex;
+};
+
+#endif // MATRIXCACHE_H
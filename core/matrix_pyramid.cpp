@@ -0,0 +1,196 @@
+#include "matrix_pyramid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+namespace
+{
+size_t divideRoundingUp(size_t value, size_t divisor)
+{
+    return (value + divisor - 1) / divisor;
+}
+}
+
+MatrixPyramid::MatrixPyramid(const Matrix& matrix, size_t baseResolution /*= DEFAULT_BASE_RESOLUTION*/)
+    : matrix(matrix)
+    , baseBlockSize(1)
+    , maxAbs(0.0)
+{
+    if (baseResolution == 0)
+        throw std::invalid_argument("The base resolution of the pyramid must be positive");
+
+    size_t size = std::max(getNumRows(), getNumColumns());
+    while (divideRoundingUp(size, baseBlockSize) > baseResolution)
+        baseBlockSize *= 2;
+
+    buildBaseLevel();
+    while ((levels.back().numRows > 1) || (levels.back().numColumns > 1))
+        buildLevel(levels.back());
+}
+
+size_t MatrixPyramid::getNumRows() const
+{
+    return matrix.getNumRows();
+}
+
+size_t MatrixPyramid::getNumColumns() const
+{
+    return (matrix.getNumRows() == 0) ? 0 : matrix.getNumColumns();
+}
+
+size_t MatrixPyramid::getBaseBlockSize() const
+{
+    return baseBlockSize;
+}
+
+size_t MatrixPyramid::getNumLevels() const
+{
+    return levels.size();
+}
+
+double MatrixPyramid::getMaxAbs() const
+{
+    return maxAbs;
+}
+
+BlockSummary MatrixPyramid::getBlock(size_t blockSize, size_t blockRow, size_t blockColumn) const
+{
+    if ((blockSize == 0) || (blockSize & (blockSize - 1)))
+        throw std::invalid_argument("The block size must be a power of two");
+
+    if (blockSize < baseBlockSize)
+    {
+        if ((blockRow * blockSize >= getNumRows()) || (blockColumn * blockSize >= getNumColumns()))
+            return BlockSummary();
+
+        return summarize(blockRow * blockSize, blockColumn * blockSize, blockSize);
+    }
+
+    size_t levelIndex = 0;
+    while ((baseBlockSize << levelIndex) < blockSize)
+        ++levelIndex;
+
+    if (levelIndex >= levels.size())
+        return (blockRow == 0 && blockColumn == 0) ? levels.back().blocks.front() : BlockSummary();
+
+    const Level& level = levels[levelIndex];
+    if ((blockRow >= level.numRows) || (blockColumn >= level.numColumns))
+        return BlockSummary();
+
+    return level.blocks[blockRow * level.numColumns + blockColumn];
+}
+
+void MatrixPyramid::buildBaseLevel()
+{
+    Level level;
+    level.numRows = std::max<size_t>(divideRoundingUp(getNumRows(), baseBlockSize), 1);
+    level.numColumns = std::max<size_t>(divideRoundingUp(getNumColumns(), baseBlockSize), 1);
+    level.blocks.resize(level.numRows * level.numColumns);
+
+    std::vector<double> sums(level.numColumns);
+    std::vector<size_t> counts(level.numColumns);
+
+    matrix.adviseAccess(AccessPattern::Sequential);
+
+    for (size_t blockRow = 0; blockRow < level.numRows; ++blockRow)
+    {
+        std::fill(sums.begin(), sums.end(), 0.0);
+        std::fill(counts.begin(), counts.end(), 0);
+        BlockSummary* blocks = level.blocks.data() + blockRow * level.numColumns;
+
+        size_t firstRow = blockRow * baseBlockSize;
+        size_t lastRow = std::min(firstRow + baseBlockSize, getNumRows());
+        for (size_t rowIndex = firstRow; rowIndex < lastRow; ++rowIndex)
+        {
+            const Vector& row = matrix[rowIndex];
+            for (size_t columnIndex = 0; columnIndex < row.size(); ++columnIndex)
+            {
+                double value = std::abs(row[columnIndex]);
+                size_t blockColumn = columnIndex / baseBlockSize;
+
+                blocks[blockColumn].maxAbs = std::max(blocks[blockColumn].maxAbs, static_cast<float>(value));
+                sums[blockColumn] += value;
+                counts[blockColumn] += (value != 0.0);
+            }
+        }
+
+        size_t numRows = lastRow - firstRow;
+        for (size_t blockColumn = 0; blockColumn < level.numColumns; ++blockColumn)
+        {
+            size_t numColumns = std::min(baseBlockSize, getNumColumns() - std::min(getNumColumns(), blockColumn * baseBlockSize));
+            double numElements = static_cast<double>(numRows * numColumns);
+            if (numElements == 0.0)
+                continue;
+
+            blocks[blockColumn].meanAbs = static_cast<float>(sums[blockColumn] / numElements);
+            blocks[blockColumn].density = static_cast<float>(counts[blockColumn] / numElements);
+            maxAbs = std::max(maxAbs, static_cast<double>(blocks[blockColumn].maxAbs));
+        }
+    }
+
+    matrix.adviseAccess(AccessPattern::Normal);
+    levels.push_back(std::move(level));
+}
+
+void MatrixPyramid::buildLevel(const Level& source)
+{
+    Level level;
+    level.numRows = divideRoundingUp(source.numRows, 2);
+    level.numColumns = divideRoundingUp(source.numColumns, 2);
+    level.blocks.resize(level.numRows * level.numColumns);
+
+    for (size_t blockRow = 0; blockRow < level.numRows; ++blockRow)
+    {
+        for (size_t blockColumn = 0; blockColumn < level.numColumns; ++blockColumn)
+        {
+            BlockSummary& block = level.blocks[blockRow * level.numColumns + blockColumn];
+            float numChildren = 0.0f;
+
+            for (size_t i = 2 * blockRow; i < std::min(2 * blockRow + 2, source.numRows); ++i)
+            {
+                for (size_t j = 2 * blockColumn; j < std::min(2 * blockColumn + 2, source.numColumns); ++j)
+                {
+                    const BlockSummary& child = source.blocks[i * source.numColumns + j];
+                    block.maxAbs = std::max(block.maxAbs, child.maxAbs);
+                    block.meanAbs += child.meanAbs;
+                    block.density += child.density;
+                    numChildren += 1.0f;
+                }
+            }
+
+            block.meanAbs /= numChildren;
+            block.density /= numChildren;
+        }
+    }
+
+    levels.push_back(std::move(level));
+}
+
+BlockSummary MatrixPyramid::summarize(size_t firstRow, size_t firstColumn, size_t blockSize) const
+{
+    size_t lastRow = std::min(firstRow + blockSize, getNumRows());
+    size_t lastColumn = std::min(firstColumn + blockSize, getNumColumns());
+
+    BlockSummary block;
+    double sum = 0.0;
+    size_t count = 0;
+
+    for (size_t rowIndex = firstRow; rowIndex < lastRow; ++rowIndex)
+    {
+        const Vector& row = matrix[rowIndex];
+        for (size_t columnIndex = firstColumn; columnIndex < lastColumn; ++columnIndex)
+        {
+            double value = std::abs(row[columnIndex]);
+            block.maxAbs = std::max(block.maxAbs, static_cast<float>(value));
+            sum += value;
+            count += (value != 0.0);
+        }
+    }
+
+    double numElements = static_cast<double>((lastRow - firstRow) * (lastColumn - firstColumn));
+    block.meanAbs = static_cast<float>(sum / numElements);
+    block.density = static_cast<float>(count / numElements);
+
+    return block;
+}
@@ -0,0 +1,48 @@
+#ifndef MATRIXPYRAMID_H
+#define MATRIXPYRAMID_H
+
+#include "matrix.h"
+
+#include <vector>
+
+struct BlockSummary
+{
+    float maxAbs = 0.0f;
+    float meanAbs = 0.0f;
+    float density = 0.0f;
+};
+
+class MatrixPyramid
+{
+public:
+    static constexpr size_t DEFAULT_BASE_RESOLUTION = 2048;
+
+    explicit MatrixPyramid(const Matrix& matrix, size_t baseResolution = DEFAULT_BASE_RESOLUTION);
+
+    size_t getNumRows() const;
+    size_t getNumColumns() const;
+    size_t getBaseBlockSize() const;
+    size_t getNumLevels() const;
+    double getMaxAbs() const;
+
+    BlockSummary getBlock(size_t blockSize, size_t blockRow, size_t blockColumn) const;
+
+private:
+    struct Level
+    {
+        size_t numRows;
+        size_t numColumns;
+        std::vector<BlockSummary> blocks;
+    };
+
+    void buildBaseLevel();
+    void buildLevel(const Level& source);
+    BlockSummary summarize(size_t firstRow, size_t firstColumn, size_t blockSize) const;
+
+    const Matrix& matrix;
+    size_t baseBlockSize;
+    double maxAbs;
+    std::vector<Level> levels;
+};
+
+#endif // MATRIXPYRAMID_H
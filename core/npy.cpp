@@ -0,0 +1,609 @@
+#include "npy.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+constexpr char MAGIC[] = "\x93NUMPY";
+constexpr size_t MAGIC_SIZE = 6;
+constexpr size_t HEADER_ALIGNMENT = 64;
+constexpr size_t CONVERSION_CHUNK = 4096;
+
+constexpr uint32_t LOCAL_HEADER_SIGNATURE = 0x04034b50;
+constexpr uint32_t CENTRAL_HEADER_SIGNATURE = 0x02014b50;
+constexpr uint32_t END_OF_DIRECTORY_SIGNATURE = 0x06054b50;
+constexpr uint32_t ZIP64_END_OF_DIRECTORY_SIGNATURE = 0x06064b50;
+constexpr uint32_t ZIP64_LOCATOR_SIGNATURE = 0x07064b50;
+constexpr uint16_t ZIP64_EXTRA_ID = 0x0001;
+constexpr uint16_t ZIP64_VERSION = 45;
+constexpr uint16_t DOS_DATE_1980 = 0x21;
+constexpr uint32_t SATURATED_32 = 0xFFFFFFFF;
+constexpr uint16_t SATURATED_16 = 0xFFFF;
+
+bool isLittleEndian()
+{
+    const uint16_t probe = 1;
+    unsigned char firstByte = 0;
+    std::memcpy(&firstByte, &probe, 1);
+    return firstByte == 1;
+}
+
+template <typename T>
+T readLittleEndian(const char* data, size_t size, size_t offset)
+{
+    if ((offset > size) || (size - offset < sizeof(T)))
+        throw std::invalid_argument("Invalid .npz archive: unexpected end of file");
+
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i)
+        value |= static_cast<T>(static_cast<unsigned char>(data[offset + i])) << (8 * i);
+
+    return value;
+}
+
+template <typename T>
+void writeLittleEndian(std::ostream& output, T value)
+{
+    char bytes[sizeof(T)];
+    for (size_t i = 0; i < sizeof(T); ++i)
+        bytes[i] = static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+
+    output.write(bytes, sizeof(T));
+}
+
+template <typename T>
+T loadValue(const char* source, bool swapBytes)
+{
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, source, sizeof(T));
+    if (swapBytes)
+        std::reverse(bytes, bytes + sizeof(T));
+
+    T value;
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+const std::array<uint32_t, 256>& getChecksumTable()
+{
+    static const std::array<uint32_t, 256> table = []()
+    {
+        std::array<uint32_t, 256> result{};
+        for (uint32_t n = 0; n < 256; ++n)
+        {
+            uint32_t c = n;
+            for (int k = 0; k < 8; ++k)
+                c = (c & 1) ? (0xEDB88320 ^ (c >> 1)) : (c >> 1);
+            result[n] = c;
+        }
+        return result;
+    }();
+
+    return table;
+}
+
+uint32_t updateChecksum(uint32_t checksum, const char* data, size_t size)
+{
+    const auto& table = getChecksumTable();
+
+    checksum = ~checksum;
+    for (size_t i = 0; i < size; ++i)
+        checksum = table[(checksum ^ static_cast<unsigned char>(data[i])) & 0xFF] ^ (checksum >> 8);
+
+    return ~checksum;
+}
+
+size_t findKey(const std::string& header, const std::string& key)
+{
+    for (char quote : { '\'', '"' })
+    {
+        size_t position = header.find(quote + key + quote);
+        if (position == std::string::npos)
+            continue;
+
+        position = header.find(':', position + key.size() + 2);
+        if (position == std::string::npos)
+            break;
+
+        return header.find_first_not_of(" \t", position + 1);
+    }
+
+    throw std::invalid_argument("Invalid .npy header: missing key '" + key + "'");
+}
+
+void parseDescriptor(const std::string& header, npy::Header& result)
+{
+    size_t position = findKey(header, "descr");
+    if ((position == std::string::npos) || ((header[position] != '\'') && (header[position] != '"')))
+        throw std::invalid_argument("Invalid .npy header: malformed 'descr'");
+
+    size_t end = header.find(header[position], position + 1);
+    if (end == std::string::npos)
+        throw std::invalid_argument("Invalid .npy header: malformed 'descr'");
+
+    std::string descriptor = header.substr(position + 1, end - position - 1);
+    if (descriptor.size() != 3)
+        throw std::invalid_argument("Unsupported .npy data type: " + descriptor);
+
+    char byteOrder = descriptor[0];
+    std::string kind = descriptor.substr(1);
+
+    if (kind == "f8")
+        result.type = npy::DataType::Float64;
+    else if (kind == "f4")
+        result.type = npy::DataType::Float32;
+    else
+        throw std::invalid_argument("Unsupported .npy data type: " + descriptor);
+
+    if (byteOrder == '<')
+        result.swapBytes = !isLittleEndian();
+    else if (byteOrder == '>')
+        result.swapBytes = isLittleEndian();
+    else if ((byteOrder == '=') || (byteOrder == '|'))
+        result.swapBytes = false;
+    else
+        throw std::invalid_argument("Unsupported .npy data type: " + descriptor);
+}
+
+void parseOrder(const std::string& header, npy::Header& result)
+{
+    size_t position = findKey(header, "fortran_order");
+
+    if (header.compare(position, 4, "True") == 0)
+        result.order = npy::Order::Fortran;
+    else if (header.compare(position, 5, "False") == 0)
+        result.order = npy::Order::C;
+    else
+        throw std::invalid_argument("Invalid .npy header: malformed 'fortran_order'");
+}
+
+void parseShape(const std::string& header, npy::Header& result)
+{
+    size_t position = findKey(header, "shape");
+    if ((position == std::string::npos) || (header[position] != '('))
+        throw std::invalid_argument("Invalid .npy header: malformed 'shape'");
+
+    size_t end = header.find(')', position);
+    if (end == std::string::npos)
+        throw std::invalid_argument("Invalid .npy header: malformed 'shape'");
+
+    std::string dimensions = header.substr(position + 1, end - position - 1);
+    std::replace(dimensions.begin(), dimensions.end(), ',', ' ');
+
+    std::istringstream ss(dimensions);
+    std::string token;
+    while (ss >> token)
+    {
+        if (token.find_first_not_of("0123456789") != std::string::npos)
+            throw std::invalid_argument("Invalid .npy header: malformed 'shape'");
+
+        result.shape.push_back(std::stoull(token));
+    }
+}
+
+std::string getDescriptor(npy::DataType type)
+{
+    std::string descriptor = isLittleEndian() ? "<" : ">";
+    descriptor += (type == npy::DataType::Float64) ? "f8" : "f4";
+    return descriptor;
+}
+}
+
+namespace npy
+{
+class ChecksumBuffer : public std::streambuf
+{
+public:
+    explicit ChecksumBuffer(std::streambuf* target)
+        : target(target)
+    {
+    }
+
+    uint32_t getChecksum() const
+    {
+        return checksum;
+    }
+
+    uint64_t getSize() const
+    {
+        return size;
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (traits_type::eq_int_type(ch, traits_type::eof()))
+            return traits_type::not_eof(ch);
+
+        char value = traits_type::to_char_type(ch);
+        return (xsputn(&value, 1) == 1) ? ch : traits_type::eof();
+    }
+
+    std::streamsize xsputn(const char* data, std::streamsize count) override
+    {
+        std::streamsize written = target->sputn(data, count);
+        checksum = updateChecksum(checksum, data, static_cast<size_t>(written));
+        size += static_cast<uint64_t>(written);
+        return written;
+    }
+
+private:
+    std::streambuf* target;
+    uint32_t checksum = 0;
+    uint64_t size = 0;
+};
+
+size_t Header::itemSize() const
+{
+    return (type == DataType::Float64) ? sizeof(double) : sizeof(float);
+}
+
+size_t Header::numElements() const
+{
+    size_t count = 1;
+    for (size_t dimension : shape)
+        count *= dimension;
+
+    return count;
+}
+
+Header parseHeader(const char* data, size_t size)
+{
+    if ((size < MAGIC_SIZE + 4) || (std::memcmp(data, MAGIC, MAGIC_SIZE) != 0))
+        throw std::invalid_argument("Invalid .npy file: bad magic string");
+
+    unsigned char majorVersion = static_cast<unsigned char>(data[MAGIC_SIZE]);
+
+    size_t headerLength = 0;
+    size_t headerStart = 0;
+    if (majorVersion == 1)
+    {
+        headerLength = readLittleEndian<uint16_t>(data, size, MAGIC_SIZE + 2);
+        headerStart = MAGIC_SIZE + 4;
+    }
+    else if ((majorVersion == 2) || (majorVersion == 3))
+    {
+        headerLength = readLittleEndian<uint32_t>(data, size, MAGIC_SIZE + 2);
+        headerStart = MAGIC_SIZE + 6;
+    }
+    else
+    {
+        throw std::invalid_argument("Unsupported .npy format version: " + std::to_string(majorVersion));
+    }
+
+    if (headerStart + headerLength > size)
+        throw std::invalid_argument("Invalid .npy file: truncated header");
+
+    std::string text(data + headerStart, headerLength);
+
+    Header header;
+    parseDescriptor(text, header);
+    parseOrder(text, header);
+    parseShape(text, header);
+    header.dataOffset = headerStart + headerLength;
+
+    if ((size - header.dataOffset) / header.itemSize() < header.numElements())
+        throw std::invalid_argument("Invalid .npy file: truncated data");
+
+    return header;
+}
+
+void writeHeader(std::ostream& output, DataType type, Order order, const std::vector<size_t>& shape, size_t minimumLength /*= 0*/)
+{
+    std::string dictionary = "{'descr': '" + getDescriptor(type) + "', 'fortran_order': ";
+    dictionary += (order == Order::Fortran) ? "True" : "False";
+    dictionary += ", 'shape': (";
+    for (size_t dimension : shape)
+        dictionary += std::to_string(dimension) + ", ";
+    if (shape.size() > 1)
+        dictionary.erase(dictionary.size() - 2);
+    else if (shape.size() == 1)
+        dictionary.pop_back();
+    dictionary += "), }";
+
+    size_t prefixSize = MAGIC_SIZE + 4;
+    size_t totalSize = std::max(prefixSize + dictionary.size() + 1, minimumLength);
+    size_t padding = totalSize - (prefixSize + dictionary.size() + 1);
+    padding += (HEADER_ALIGNMENT - totalSize % HEADER_ALIGNMENT) % HEADER_ALIGNMENT;
+    dictionary.append(padding, ' ');
+    dictionary += '\n';
+
+    if (dictionary.size() > 0xFFFF)
+        throw std::invalid_argument("The .npy header is too long");
+
+    output.write(MAGIC, MAGIC_SIZE);
+    output.put(1);
+    output.put(0);
+    writeLittleEndian<uint16_t>(output, static_cast<uint16_t>(dictionary.size()));
+    output.write(dictionary.data(), dictionary.size());
+}
+
+void readValues(const char* source, const Header& header, size_t count, double* destination)
+{
+    if (header.type == DataType::Float64)
+    {
+        if (!header.swapBytes)
+        {
+            std::memcpy(destination, source, count * sizeof(double));
+            return;
+        }
+
+        for (size_t i = 0; i < count; ++i)
+            destination[i] = loadValue<double>(source + i * sizeof(double), true);
+    }
+    else
+    {
+        for (size_t i = 0; i < count; ++i)
+            destination[i] = loadValue<float>(source + i * sizeof(float), header.swapBytes);
+    }
+}
+
+void writeValues(std::ostream& output, const double* values, size_t count, DataType type)
+{
+    if (type == DataType::Float64)
+    {
+        output.write(reinterpret_cast<const char*>(values), static_cast<std::streamsize>(count * sizeof(double)));
+        return;
+    }
+
+    std::array<float, CONVERSION_CHUNK> chunk;
+    for (size_t start = 0; start < count; start += CONVERSION_CHUNK)
+    {
+        size_t chunkSize = std::min(CONVERSION_CHUNK, count - start);
+        for (size_t i = 0; i < chunkSize; ++i)
+            chunk[i] = static_cast<float>(values[start + i]);
+
+        output.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunkSize * sizeof(float)));
+    }
+}
+
+std::vector<ArchiveEntry> readArchiveDirectory(const char* data, size_t size)
+{
+    if (size < 22)
+        throw std::invalid_argument("Invalid .npz archive: too small");
+
+    size_t endOfDirectory = std::string::npos;
+    size_t lowestOffset = (size > 22 + 0xFFFF) ? size - 22 - 0xFFFF : 0;
+    for (size_t offset = size - 22 + 1; offset-- > lowestOffset;)
+    {
+        if (readLittleEndian<uint32_t>(data, size, offset) == END_OF_DIRECTORY_SIGNATURE)
+        {
+            endOfDirectory = offset;
+            break;
+        }
+    }
+
+    if (endOfDirectory == std::string::npos)
+        throw std::invalid_argument("Invalid .npz archive: missing central directory");
+
+    uint64_t numEntries = readLittleEndian<uint16_t>(data, size, endOfDirectory + 10);
+    uint64_t directoryOffset = readLittleEndian<uint32_t>(data, size, endOfDirectory + 16);
+
+    if ((endOfDirectory >= 20) && (readLittleEndian<uint32_t>(data, size, endOfDirectory - 20) == ZIP64_LOCATOR_SIGNATURE))
+    {
+        uint64_t zip64Record = readLittleEndian<uint64_t>(data, size, endOfDirectory - 20 + 8);
+        if (readLittleEndian<uint32_t>(data, size, zip64Record) != ZIP64_END_OF_DIRECTORY_SIGNATURE)
+            throw std::invalid_argument("Invalid .npz archive: malformed zip64 record");
+
+        numEntries = readLittleEndian<uint64_t>(data, size, zip64Record + 32);
+        directoryOffset = readLittleEndian<uint64_t>(data, size, zip64Record + 48);
+    }
+
+    std::vector<ArchiveEntry> entries;
+
+    size_t offset = directoryOffset;
+    for (uint64_t index = 0; index < numEntries; ++index)
+    {
+        if (readLittleEndian<uint32_t>(data, size, offset) != CENTRAL_HEADER_SIGNATURE)
+            throw std::invalid_argument("Invalid .npz archive: malformed central directory");
+
+        uint16_t method = readLittleEndian<uint16_t>(data, size, offset + 10);
+        uint64_t compressedSize = readLittleEndian<uint32_t>(data, size, offset + 20);
+        uint64_t uncompressedSize = readLittleEndian<uint32_t>(data, size, offset + 24);
+        uint16_t nameLength = readLittleEndian<uint16_t>(data, size, offset + 28);
+        uint16_t extraLength = readLittleEndian<uint16_t>(data, size, offset + 30);
+        uint16_t commentLength = readLittleEndian<uint16_t>(data, size, offset + 32);
+        uint64_t localHeader = readLittleEndian<uint32_t>(data, size, offset + 42);
+
+        size_t nameOffset = offset + 46;
+        if (nameOffset + nameLength + extraLength > size)
+            throw std::invalid_argument("Invalid .npz archive: malformed central directory");
+
+        std::string name(data + nameOffset, nameLength);
+
+        size_t extra = nameOffset + nameLength;
+        size_t extraEnd = extra + extraLength;
+        while (extra + 4 <= extraEnd)
+        {
+            uint16_t id = readLittleEndian<uint16_t>(data, size, extra);
+            uint16_t length = readLittleEndian<uint16_t>(data, size, extra + 2);
+            if (id == ZIP64_EXTRA_ID)
+            {
+                size_t field = extra + 4;
+                if (uncompressedSize == SATURATED_32)
+                {
+                    uncompressedSize = readLittleEndian<uint64_t>(data, size, field);
+                    field += 8;
+                }
+                if (compressedSize == SATURATED_32)
+                {
+                    compressedSize = readLittleEndian<uint64_t>(data, size, field);
+                    field += 8;
+                }
+                if (localHeader == SATURATED_32)
+                    localHeader = readLittleEndian<uint64_t>(data, size, field);
+            }
+            extra += 4 + length;
+        }
+
+        if (method != 0)
+            throw std::invalid_argument("Compressed .npz archives are not supported: " + name);
+
+        if (readLittleEndian<uint32_t>(data, size, localHeader) != LOCAL_HEADER_SIGNATURE)
+            throw std::invalid_argument("Invalid .npz archive: malformed local header");
+
+        uint16_t localNameLength = readLittleEndian<uint16_t>(data, size, localHeader + 26);
+        uint16_t localExtraLength = readLittleEndian<uint16_t>(data, size, localHeader + 28);
+
+        ArchiveEntry entry;
+        entry.name = name;
+        entry.offset = localHeader + 30 + localNameLength + localExtraLength;
+        entry.size = uncompressedSize;
+
+        if ((entry.offset > size) || (size - entry.offset < entry.size))
+            throw std::invalid_argument("Invalid .npz archive: truncated entry " + name);
+
+        entries.push_back(entry);
+        offset = extraEnd + commentLength;
+    }
+
+    return entries;
+}
+
+ArchiveWriter::ArchiveWriter(const std::string& filepath)
+    : file(filepath, std::ios_base::binary | std::ios_base::trunc)
+{
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to create a file: " + filepath);
+}
+
+ArchiveWriter::~ArchiveWriter()
+{
+    try
+    {
+        close();
+    }
+    catch (...)
+    {
+    }
+}
+
+std::ostream& ArchiveWriter::beginEntry(const std::string& name)
+{
+    if (entryStream)
+        endEntry();
+
+    Entry entry;
+    entry.name = name;
+    entry.offset = static_cast<uint64_t>(file.tellp());
+    entries.push_back(entry);
+
+    writeLittleEndian<uint32_t>(file, LOCAL_HEADER_SIGNATURE);
+    writeLittleEndian<uint16_t>(file, ZIP64_VERSION);
+    writeLittleEndian<uint16_t>(file, 0);
+    writeLittleEndian<uint16_t>(file, 0);
+    writeLittleEndian<uint16_t>(file, 0);
+    writeLittleEndian<uint16_t>(file, DOS_DATE_1980);
+    writeLittleEndian<uint32_t>(file, 0);
+    writeLittleEndian<uint32_t>(file, SATURATED_32);
+    writeLittleEndian<uint32_t>(file, SATURATED_32);
+    writeLittleEndian<uint16_t>(file, static_cast<uint16_t>(name.size()));
+    writeLittleEndian<uint16_t>(file, 20);
+    file.write(name.data(), name.size());
+    writeLittleEndian<uint16_t>(file, ZIP64_EXTRA_ID);
+    writeLittleEndian<uint16_t>(file, 16);
+    writeLittleEndian<uint64_t>(file, 0);
+    writeLittleEndian<uint64_t>(file, 0);
+
+    buffer = std::make_unique<ChecksumBuffer>(file.rdbuf());
+    entryStream = std::make_unique<std::ostream>(buffer.get());
+    return *entryStream;
+}
+
+void ArchiveWriter::endEntry()
+{
+    if (!entryStream)
+        return;
+
+    entryStream->flush();
+
+    Entry& entry = entries.back();
+    entry.size = buffer->getSize();
+    entry.checksum = buffer->getChecksum();
+
+    entryStream.reset();
+    buffer.reset();
+
+    std::streampos end = file.tellp();
+
+    file.seekp(static_cast<std::streamoff>(entry.offset + 14));
+    writeLittleEndian<uint32_t>(file, entry.checksum);
+    file.seekp(static_cast<std::streamoff>(entry.offset + 30 + entry.name.size() + 4));
+    writeLittleEndian<uint64_t>(file, entry.size);
+    writeLittleEndian<uint64_t>(file, entry.size);
+
+    file.seekp(end);
+}
+
+void ArchiveWriter::close()
+{
+    if (!file.is_open())
+        return;
+
+    endEntry();
+
+    uint64_t directoryOffset = static_cast<uint64_t>(file.tellp());
+
+    for (const auto& entry : entries)
+    {
+        writeLittleEndian<uint32_t>(file, CENTRAL_HEADER_SIGNATURE);
+        writeLittleEndian<uint16_t>(file, ZIP64_VERSION);
+        writeLittleEndian<uint16_t>(file, ZIP64_VERSION);
+        writeLittleEndian<uint16_t>(file, 0);
+        writeLittleEndian<uint16_t>(file, 0);
+        writeLittleEndian<uint16_t>(file, 0);
+        writeLittleEndian<uint16_t>(file, DOS_DATE_1980);
+        writeLittleEndian<uint32_t>(file, entry.checksum);
+        writeLittleEndian<uint32_t>(file, SATURATED_32);
+        writeLittleEndian<uint32_t>(file, SATURATED_32);
+        writeLittleEndian<uint16_t>(file, static_cast<uint16_t>(entry.name.size()));
+        writeLittleEndian<uint16_t>(file, 28);
+        writeLittleEndian<uint16_t>(file, 0);
+        writeLittleEndian<uint16_t>(file, 0);
+        writeLittleEndian<uint16_t>(file, 0);
+        writeLittleEndian<uint32_t>(file, 0);
+        writeLittleEndian<uint32_t>(file, SATURATED_32);
+        file.write(entry.name.data(), entry.name.size());
+        writeLittleEndian<uint16_t>(file, ZIP64_EXTRA_ID);
+        writeLittleEndian<uint16_t>(file, 24);
+        writeLittleEndian<uint64_t>(file, entry.size);
+        writeLittleEndian<uint64_t>(file, entry.size);
+        writeLittleEndian<uint64_t>(file, entry.offset);
+    }
+
+    uint64_t zip64Record = static_cast<uint64_t>(file.tellp());
+    uint64_t directorySize = zip64Record - directoryOffset;
+
+    writeLittleEndian<uint32_t>(file, ZIP64_END_OF_DIRECTORY_SIGNATURE);
+    writeLittleEndian<uint64_t>(file, 44);
+    writeLittleEndian<uint16_t>(file, ZIP64_VERSION);
+    writeLittleEndian<uint16_t>(file, ZIP64_VERSION);
+    writeLittleEndian<uint32_t>(file, 0);
+    writeLittleEndian<uint32_t>(file, 0);
+    writeLittleEndian<uint64_t>(file, entries.size());
+    writeLittleEndian<uint64_t>(file, entries.size());
+    writeLittleEndian<uint64_t>(file, directorySize);
+    writeLittleEndian<uint64_t>(file, directoryOffset);
+
+    writeLittleEndian<uint32_t>(file, ZIP64_LOCATOR_SIGNATURE);
+    writeLittleEndian<uint32_t>(file, 0);
+    writeLittleEndian<uint64_t>(file, zip64Record);
+    writeLittleEndian<uint32_t>(file, 1);
+
+    uint16_t numEntries = static_cast<uint16_t>(std::min<size_t>(entries.size(), SATURATED_16));
+    writeLittleEndian<uint32_t>(file, END_OF_DIRECTORY_SIGNATURE);
+    writeLittleEndian<uint16_t>(file, 0);
+    writeLittleEndian<uint16_t>(file, 0);
+    writeLittleEndian<uint16_t>(file, numEntries);
+    writeLittleEndian<uint16_t>(file, numEntries);
+    writeLittleEndian<uint32_t>(file, SATURATED_32);
+    writeLittleEndian<uint32_t>(file, SATURATED_32);
+    writeLittleEndian<uint16_t>(file, 0);
+
+    file.close();
+}
+}
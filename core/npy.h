@@ -0,0 +1,79 @@
+#ifndef NPY_H
+#define NPY_H
+
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace npy
+{
+enum class DataType
+{
+    Float32,
+    Float64
+};
+
+enum class Order
+{
+    C,
+    Fortran
+};
+
+struct Header
+{
+    DataType type = DataType::Float64;
+    Order order = Order::C;
+    bool swapBytes = false;
+    std::vector<size_t> shape;
+    size_t dataOffset = 0;
+
+    size_t itemSize() const;
+    size_t numElements() const;
+};
+
+Header parseHeader(const char* data, size_t size);
+void writeHeader(std::ostream& output, DataType type, Order order, const std::vector<size_t>& shape, size_t minimumLength = 0);
+
+void readValues(const char* source, const Header& header, size_t count, double* destination);
+void writeValues(std::ostream& output, const double* values, size_t count, DataType type);
+
+struct ArchiveEntry
+{
+    std::string name;
+    size_t offset = 0;
+    size_t size = 0;
+};
+
+std::vector<ArchiveEntry> readArchiveDirectory(const char* data, size_t size);
+
+class ChecksumBuffer;
+
+class ArchiveWriter
+{
+public:
+    explicit ArchiveWriter(const std::string& filepath);
+    ~ArchiveWriter();
+
+    std::ostream& beginEntry(const std::string& name);
+    void endEntry();
+    void close();
+
+private:
+    struct Entry
+    {
+        std::string name;
+        uint64_t offset = 0;
+        uint64_t size = 0;
+        uint32_t checksum = 0;
+    };
+
+    std::ofstream file;
+    std::vector<Entry> entries;
+    std::unique_ptr<ChecksumBuffer> buffer;
+    std::unique_ptr<std::ostream> entryStream;
+};
+}
+
+#endif // NPY_H
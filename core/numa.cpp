@@ -0,0 +1,136 @@
+#include "numa.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+#include <linux/mempolicy.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace numa
+{
+namespace
+{
+constexpr const char* NODE_DIRECTORY = "/sys/devices/system/node/";
+constexpr size_t MAX_NODES = 64;
+
+std::atomic<MemoryPlacement> currentPlacement{ MemoryPlacement::FirstTouch };
+
+// Parses kernel cpu lists such as "0-3,8-11"
+std::vector<size_t> parseList(const std::string& text)
+{
+    std::vector<size_t> values;
+
+    std::istringstream input(text);
+    for (std::string range; std::getline(input, range, ',');)
+    {
+        size_t dash = range.find('-');
+        try
+        {
+            size_t first = std::stoul(range.substr(0, dash));
+            size_t last = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+            for (size_t value = first; value <= last; ++value)
+                values.push_back(value);
+        }
+        catch (const std::exception&)
+        {
+        }
+    }
+
+    return values;
+}
+
+std::string readLine(const std::string& filepath)
+{
+    std::ifstream file(filepath);
+    std::string line;
+    std::getline(file, line);
+    return line;
+}
+}
+
+size_t getNumNodes()
+{
+    static const size_t numNodes = [] ()
+    {
+        std::vector<size_t> nodes = parseList(readLine(std::string(NODE_DIRECTORY) + "online"));
+        return nodes.empty() ? size_t(1) : std::min(nodes.back() + 1, MAX_NODES);
+    }();
+
+    return numNodes;
+}
+
+std::vector<size_t> getNodeCpus(size_t node)
+{
+    return parseList(readLine(std::string(NODE_DIRECTORY) + "node" + std::to_string(node) + "/cpulist"));
+}
+
+size_t getNodeOfThread(size_t threadIndex, size_t numThreads)
+{
+    // Consecutive threads share a node. parallelFor runs chunk 0 on the caller (thread 0) and deals chunk c
+    // to thread 1 + (c - 1) % workers, so a chunk lands on the same thread, and node, on every call and
+    // the pages it touched first stay local
+    return (numThreads == 0) ? 0 : threadIndex * getNumNodes() / numThreads;
+}
+
+bool bindCurrentThreadToNode(size_t node)
+{
+#ifdef __linux__
+    std::vector<size_t> cpus = getNodeCpus(node);
+    if (cpus.empty())
+        return false;
+
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (size_t cpu : cpus)
+        if (cpu < CPU_SETSIZE)
+            CPU_SET(cpu, &set);
+
+    // The default local policy then keeps the pages this thread touches first on its own node
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)node;
+    return false;
+#endif
+}
+
+void setMemoryPlacement(MemoryPlacement placement)
+{
+    currentPlacement.store(placement, std::memory_order_relaxed);
+}
+
+MemoryPlacement getMemoryPlacement()
+{
+    return currentPlacement.load(std::memory_order_relaxed);
+}
+
+ScopedInterleave::ScopedInterleave()
+{
+#ifdef __linux__
+    size_t numNodes = getNumNodes();
+    if (numNodes < 2)
+        return;
+
+    if (syscall(SYS_get_mempolicy, &previousMode, &previousMask, MAX_NODES + 1, nullptr, 0ul) != 0)
+        return;
+
+    unsigned long mask = (numNodes >= MAX_NODES) ? ~0ul : (1ul << numNodes) - 1;
+    active = syscall(SYS_set_mempolicy, MPOL_INTERLEAVE, &mask, MAX_NODES + 1) == 0;
+#endif
+}
+
+ScopedInterleave::~ScopedInterleave()
+{
+#ifdef __linux__
+    if (active)
+        syscall(SYS_set_mempolicy, previousMode, (previousMode == MPOL_DEFAULT) ? nullptr : &previousMask, MAX_NODES + 1);
+#endif
+}
+}
@@ -0,0 +1,43 @@
+#ifndef NUMA_H
+#define NUMA_H
+
+#include <cstddef>
+#include <vector>
+
+namespace numa
+{
+enum class MemoryPlacement
+{
+    // Rows are allocated and zeroed by the pool threads, so pages land next to the threads that process them
+    FirstTouch,
+    // Pages are spread round-robin over all nodes
+    Interleaved
+};
+
+size_t getNumNodes();
+std::vector<size_t> getNodeCpus(size_t node);
+size_t getNodeOfThread(size_t threadIndex, size_t numThreads);
+
+bool bindCurrentThreadToNode(size_t node);
+
+void setMemoryPlacement(MemoryPlacement placement);
+MemoryPlacement getMemoryPlacement();
+
+// Makes the pages the calling thread faults in while it is alive interleaved over all nodes
+class ScopedInterleave
+{
+public:
+    ScopedInterleave();
+    ScopedInterleave(const ScopedInterleave&) = delete;
+    ~ScopedInterleave();
+
+    ScopedInterleave& operator=(const ScopedInterleave&) = delete;
+
+private:
+    bool active = false;
+    int previousMode = 0;
+    unsigned long previousMask = 0;
+};
+}
+
+#endif // NUMA_H
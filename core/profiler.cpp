@@ -0,0 +1,390 @@
+#include "profiler.h"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+namespace profiler
+{
+namespace
+{
+struct TraceEvent
+{
+    const char* name;
+    int64_t begin;
+    int64_t end;
+};
+
+struct TraceBuffer
+{
+    explicit TraceBuffer(size_t capacity)
+        : events(capacity)
+    {
+    }
+
+    std::vector<TraceEvent> events;
+    std::atomic<size_t> count{ 0 };
+    std::atomic<uint64_t> dropped{ 0 };
+    std::string threadName;
+    size_t threadId = 0;
+};
+
+struct Tracer
+{
+    std::atomic<bool> enabled{ false };
+    std::atomic<int64_t> epoch{ 0 };
+    std::atomic<uint64_t> generation{ 0 };
+    size_t capacity = DEFAULT_TRACE_CAPACITY;
+    std::mutex mutex;
+    std::vector<std::shared_ptr<TraceBuffer>> buffers;
+};
+
+struct ThreadTrace
+{
+    std::shared_ptr<TraceBuffer> buffer;
+    uint64_t generation = 0;
+    std::string name;
+};
+
+thread_local ThreadTrace threadTrace;
+
+Tracer& getTracer()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+int64_t getTicks(std::chrono::steady_clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+TraceBuffer& getTraceBuffer()
+{
+    Tracer& tracer = getTracer();
+    if (threadTrace.buffer && threadTrace.generation == tracer.generation.load(std::memory_order_acquire))
+        return *threadTrace.buffer;
+
+    std::lock_guard<std::mutex> lock(tracer.mutex);
+    threadTrace.buffer = std::make_shared<TraceBuffer>(tracer.capacity);
+    threadTrace.buffer->threadName = threadTrace.name;
+    threadTrace.buffer->threadId = tracer.buffers.size() + 1;
+    threadTrace.generation = tracer.generation.load(std::memory_order_relaxed);
+    tracer.buffers.push_back(threadTrace.buffer);
+
+    return *threadTrace.buffer;
+}
+
+void recordEvent(const char* name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end)
+{
+    int64_t epoch = getTracer().epoch.load(std::memory_order_acquire);
+    if (getTicks(begin) < epoch)
+        return;
+
+    TraceBuffer& buffer = getTraceBuffer();
+    size_t count = buffer.count.load(std::memory_order_relaxed);
+    if (count == buffer.events.size())
+    {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[count] = { name, getTicks(begin) - epoch, getTicks(end) - epoch };
+    buffer.count.store(count + 1, std::memory_order_release);
+}
+
+void writeJsonString(std::ostream& output, const std::string& value)
+{
+    output << '"';
+    for (char symbol : value)
+    {
+        if (symbol == '"' || symbol == '\\')
+            output << '\\' << symbol;
+        else if (static_cast<unsigned char>(symbol) < 0x20)
+            output << ' ';
+        else
+            output << symbol;
+    }
+    output << '"';
+}
+
+void writeMicroseconds(std::ostream& output, int64_t nanoseconds)
+{
+    output << nanoseconds / 1000 << '.' << static_cast<char>('0' + nanoseconds % 1000 / 100)
+           << static_cast<char>('0' + nanoseconds % 100 / 10) << static_cast<char>('0' + nanoseconds % 10);
+}
+
+struct State
+{
+    Profile* profile = nullptr;
+    std::vector<PhaseProfile>* phases = nullptr;
+    std::vector<size_t> stack;
+    size_t base = 0;
+};
+
+thread_local State state;
+
+PhaseProfile* getCurrentPhase()
+{
+    return (state.phases && (state.stack.size() > state.base)) ? &(*state.phases)[state.stack.back()] : nullptr;
+}
+}
+
+void Profile::clear()
+{
+    for (PhaseProfile& phase : phases)
+    {
+        phase.calls = 0;
+        phase.seconds = 0.0;
+        phase.flops = 0;
+        phase.bytes = 0;
+        phase.iterations = 0;
+        phase.counters = HardwareCounters();
+    }
+}
+
+void Profile::merge(const Profile& other)
+{
+    for (const PhaseProfile& source : other.phases)
+    {
+        if (source.calls == 0)
+            continue;
+
+        PhaseProfile& phase = phases[getPhaseIndex(source.name)];
+        phase.calls += source.calls;
+        phase.seconds += source.seconds;
+        phase.flops += source.flops;
+        phase.bytes += source.bytes;
+        phase.iterations += source.iterations;
+        phase.counters.add(source.counters);
+    }
+}
+
+const std::vector<PhaseProfile>& Profile::getPhases() const
+{
+    return phases;
+}
+
+const PhaseProfile* Profile::find(const std::string& name) const
+{
+    for (const PhaseProfile& phase : phases)
+        if (phase.name == name)
+            return &phase;
+
+    return nullptr;
+}
+
+double Profile::getTotalSeconds() const
+{
+    double seconds = 0.0;
+    for (const PhaseProfile& phase : phases)
+        if (phase.name.find('/') == std::string::npos)
+            seconds += phase.seconds;
+
+    return seconds;
+}
+
+size_t Profile::getPhaseIndex(const std::string& name)
+{
+    for (size_t index = 0; index < phases.size(); ++index)
+        if (phases[index].name == name)
+            return index;
+
+    PhaseProfile phase;
+    phase.name = name;
+    phases.push_back(std::move(phase));
+    return phases.size() - 1;
+}
+
+size_t Profile::getPhaseIndex(const PhaseProfile* parent, const char* name)
+{
+    size_t prefixLength = parent ? parent->name.size() + 1 : 0;
+    size_t nameLength = std::strlen(name);
+
+    for (size_t index = 0; index < phases.size(); ++index)
+    {
+        const std::string& candidate = phases[index].name;
+        if ((candidate.size() == prefixLength + nameLength) && (candidate.compare(prefixLength, nameLength, name) == 0) &&
+            (!parent || ((candidate[prefixLength - 1] == '/') && (candidate.compare(0, prefixLength - 1, parent->name) == 0))))
+            return index;
+    }
+
+    return getPhaseIndex(parent ? parent->name + '/' + name : std::string(name));
+}
+
+Session::Session(Profile& profile)
+    : previousProfile(state.profile)
+    , previousPhases(state.phases)
+    , previousBase(state.base)
+{
+    state.profile = &profile;
+    state.phases = &profile.phases;
+    state.base = state.stack.size();
+}
+
+Session::~Session()
+{
+    state.stack.resize(state.base);
+    state.profile = previousProfile;
+    state.phases = previousPhases;
+    state.base = previousBase;
+}
+
+ScopedTimer::ScopedTimer(const char* name)
+    : ScopedTimer(name, true)
+{
+}
+
+ScopedTimer::ScopedTimer(const char* name, bool profiled)
+    : name(name)
+    , profile(profiled ? state.profile : nullptr)
+    , traced(isTracing())
+{
+    if (profile)
+    {
+        PhaseProfile* parent = getCurrentPhase();
+        index = profile->getPhaseIndex(parent, name);
+        state.stack.push_back(index);
+        counted = readHardwareCounters(startCounters);
+    }
+
+    if (profile || traced)
+        start = std::chrono::steady_clock::now();
+}
+
+ScopedTimer::~ScopedTimer()
+{
+    if (!profile && !traced)
+        return;
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    if (profile)
+    {
+        PhaseProfile& phase = profile->phases[index];
+        phase.seconds += std::chrono::duration<double>(end - start).count();
+        ++phase.calls;
+
+        HardwareCounters endCounters;
+        if (counted && readHardwareCounters(endCounters))
+            phase.counters.accumulate(startCounters, endCounters);
+
+        state.stack.pop_back();
+    }
+
+    if (traced)
+        recordEvent(name, start, end);
+}
+
+void addFlops(uint64_t count)
+{
+    if (PhaseProfile* phase = getCurrentPhase())
+        phase->flops += count;
+}
+
+void addBytes(uint64_t count)
+{
+    if (PhaseProfile* phase = getCurrentPhase())
+        phase->bytes += count;
+}
+
+void addIterations(uint64_t count)
+{
+    if (PhaseProfile* phase = getCurrentPhase())
+        phase->iterations += count;
+}
+
+void startTracing(size_t capacityPerThread /*= DEFAULT_TRACE_CAPACITY*/)
+{
+    if (capacityPerThread == 0)
+        throw std::invalid_argument("Trace buffer capacity must be positive");
+
+    Tracer& tracer = getTracer();
+    std::lock_guard<std::mutex> lock(tracer.mutex);
+
+    tracer.buffers.clear();
+    tracer.capacity = capacityPerThread;
+    tracer.epoch.store(getTicks(std::chrono::steady_clock::now()), std::memory_order_release);
+    tracer.generation.fetch_add(1, std::memory_order_release);
+    tracer.enabled.store(true, std::memory_order_release);
+}
+
+void stopTracing()
+{
+    getTracer().enabled.store(false, std::memory_order_release);
+}
+
+bool isTracing()
+{
+    return getTracer().enabled.load(std::memory_order_acquire);
+}
+
+void setThreadName(const std::string& name)
+{
+    threadTrace.name = name;
+
+    Tracer& tracer = getTracer();
+    std::lock_guard<std::mutex> lock(tracer.mutex);
+    if (threadTrace.buffer && threadTrace.generation == tracer.generation.load(std::memory_order_relaxed))
+        threadTrace.buffer->threadName = name;
+}
+
+uint64_t getNumDroppedTraceEvents()
+{
+    Tracer& tracer = getTracer();
+    std::lock_guard<std::mutex> lock(tracer.mutex);
+
+    uint64_t dropped = 0;
+    for (const std::shared_ptr<TraceBuffer>& buffer : tracer.buffers)
+        dropped += buffer->dropped.load(std::memory_order_relaxed);
+
+    return dropped;
+}
+
+void writeChromeTrace(std::ostream& output)
+{
+    Tracer& tracer = getTracer();
+    std::lock_guard<std::mutex> lock(tracer.mutex);
+
+    output << "{\"traceEvents\":[\n";
+    output << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"linear_algebra\"}}";
+
+    for (const std::shared_ptr<TraceBuffer>& buffer : tracer.buffers)
+    {
+        std::string threadName = buffer->threadName.empty() ? "thread " + std::to_string(buffer->threadId) : buffer->threadName;
+        output << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":";
+        writeJsonString(output, threadName);
+        output << "}}";
+
+        size_t count = buffer->count.load(std::memory_order_acquire);
+        for (size_t index = 0; index < count; ++index)
+        {
+            const TraceEvent& event = buffer->events[index];
+            output << ",\n{\"name\":";
+            writeJsonString(output, event.name);
+            output << ",\"cat\":\"solver\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":";
+            writeMicroseconds(output, event.begin);
+            output << ",\"dur\":";
+            writeMicroseconds(output, event.end - event.begin);
+            output << '}';
+        }
+    }
+
+    output << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
+
+void writeChromeTrace(const std::string& filepath)
+{
+    std::ofstream output(filepath);
+    if (!output.is_open())
+        throw std::runtime_error("Failed to open trace file");
+
+    writeChromeTrace(output);
+    if (!output)
+        throw std::runtime_error("Failed to write trace file");
+}
+}
@@ -0,0 +1,126 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "hardware_counters.h"
+
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#ifdef LINEAR_ALGEBRA_PROFILING
+#define PROFILER_CONCATENATE_IMPL(lhs, rhs) lhs##rhs
+#define PROFILER_CONCATENATE(lhs, rhs) PROFILER_CONCATENATE_IMPL(lhs, rhs)
+#define PROFILE_SESSION(profile) profiler::Session PROFILER_CONCATENATE(profilerSession, __LINE__)(profile)
+#define PROFILE_SCOPE(name) profiler::ScopedTimer PROFILER_CONCATENATE(profilerScope, __LINE__)(name)
+#define PROFILE_TRACE(name) profiler::ScopedTimer PROFILER_CONCATENATE(profilerScope, __LINE__)(name, false)
+#define PROFILE_FLOPS(count) profiler::addFlops(count)
+#define PROFILE_BYTES(count) profiler::addBytes(count)
+#define PROFILE_ITERATIONS(count) profiler::addIterations(count)
+#else
+#define PROFILE_SESSION(profile) ((void)0)
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_TRACE(name) ((void)0)
+#define PROFILE_FLOPS(count) ((void)0)
+#define PROFILE_BYTES(count) ((void)0)
+#define PROFILE_ITERATIONS(count) ((void)0)
+#endif
+
+namespace profiler
+{
+struct PhaseProfile
+{
+    std::string name;
+    uint64_t calls = 0;
+    double seconds = 0.0;
+    uint64_t flops = 0;
+    uint64_t bytes = 0;
+    uint64_t iterations = 0;
+    // Counted on the thread that opened the phase only, work it hands to pool workers is not included
+    HardwareCounters counters;
+};
+
+class Profile
+{
+public:
+    // Zeroes the phases but keeps their entries, so a repeated run records without allocating
+    void clear();
+    void merge(const Profile& other);
+
+    const std::vector<PhaseProfile>& getPhases() const;
+    const PhaseProfile* find(const std::string& name) const;
+    double getTotalSeconds() const;
+
+private:
+    friend class Session;
+    friend class ScopedTimer;
+
+    size_t getPhaseIndex(const std::string& name);
+    size_t getPhaseIndex(const PhaseProfile* parent, const char* name);
+
+    std::vector<PhaseProfile> phases;
+};
+
+class Session
+{
+public:
+    explicit Session(Profile& profile);
+    Session(const Session&) = delete;
+    ~Session();
+
+    Session& operator=(const Session&) = delete;
+
+private:
+    Profile* previousProfile;
+    std::vector<PhaseProfile>* previousPhases;
+    size_t previousBase;
+};
+
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(const char* name);
+    // With profiled == false the scope only shows up in the trace, for work spread across threads
+    ScopedTimer(const char* name, bool profiled);
+    ScopedTimer(const ScopedTimer&) = delete;
+    ~ScopedTimer();
+
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    const char* name;
+    Profile* profile;
+    bool traced;
+    bool counted = false;
+    size_t index = 0;
+    std::chrono::steady_clock::time_point start;
+    HardwareCounters startCounters;
+};
+
+constexpr size_t DEFAULT_TRACE_CAPACITY = 1 << 16;
+
+constexpr bool isEnabled()
+{
+#ifdef LINEAR_ALGEBRA_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void addFlops(uint64_t count);
+void addBytes(uint64_t count);
+void addIterations(uint64_t count);
+
+void startTracing(size_t capacityPerThread = DEFAULT_TRACE_CAPACITY);
+void stopTracing();
+bool isTracing();
+void setThreadName(const std::string& name);
+
+uint64_t getNumDroppedTraceEvents();
+void writeChromeTrace(std::ostream& output);
+void writeChromeTrace(const std::string& filepath);
+}
+
+#endif // PROFILER_H
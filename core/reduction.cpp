@@ -0,0 +1,71 @@
+#include "reduction.h"
+
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+// Block sums of small reductions stay on the stack
+constexpr size_t LOCAL_BLOCKS = 256;
+
+std::atomic<ReductionMode> currentMode{ ReductionMode::Fast };
+}
+
+void setReductionMode(ReductionMode mode)
+{
+    currentMode.store(mode, std::memory_order_relaxed);
+}
+
+ReductionMode getReductionMode()
+{
+    return currentMode.load(std::memory_order_relaxed);
+}
+
+double parallelSum(size_t begin, size_t end, size_t blockSize, ReductionMode mode, const PartialSum& partial)
+{
+    if (begin >= end)
+        return 0.0;
+
+    blockSize = std::max<size_t>(blockSize, 1);
+
+    if (mode == ReductionMode::Fast)
+    {
+        std::mutex mutex;
+        double sum = 0.0;
+        parallelFor(begin, end, blockSize, [&](size_t first, size_t last)
+        {
+            double value = partial(first, last);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            sum += value;
+        });
+
+        return sum;
+    }
+
+    size_t numBlocks = (end - begin + blockSize - 1) / blockSize;
+
+    std::array<double, LOCAL_BLOCKS> localSums;
+    std::vector<double> heapSums(numBlocks > LOCAL_BLOCKS ? numBlocks : 0);
+    double* sums = heapSums.empty() ? localSums.data() : heapSums.data();
+
+    parallelFor(0, numBlocks, 1, [&](size_t first, size_t last)
+    {
+        for (size_t index = first; index < last; ++index)
+        {
+            size_t blockBegin = begin + index * blockSize;
+            sums[index] = partial(blockBegin, std::min(end, blockBegin + blockSize));
+        }
+    });
+
+    for (size_t width = 1; width < numBlocks; width *= 2)
+        for (size_t index = 0; index + width < numBlocks; index += 2 * width)
+            sums[index] += sums[index + width];
+
+    return sums[0];
+}
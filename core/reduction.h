@@ -0,0 +1,30 @@
+#ifndef REDUCTION_H
+#define REDUCTION_H
+
+#include <cstddef>
+#include <functional>
+
+enum class ReductionMode
+{
+    // Partial sums are added in the order the threads finish them
+    Fast,
+    // Fixed blocks are summed by a fixed pairwise tree, so the result does not depend on the thread count
+    Reproducible
+};
+
+using PartialSum = std::function<double(size_t begin, size_t end)>;
+
+void setReductionMode(ReductionMode mode);
+ReductionMode getReductionMode();
+
+// Sums partial(first, last) over [begin, end) split into blocks of blockSize indices.
+// blockSize should depend only on the data, never on the number of threads.
+double parallelSum(size_t begin, size_t end, size_t blockSize, ReductionMode mode, const PartialSum& partial);
+
+template <typename Partial>
+double parallelSum(size_t begin, size_t end, size_t blockSize, const Partial& partial)
+{
+    return parallelSum(begin, end, blockSize, getReductionMode(), PartialSum(std::cref(partial)));
+}
+
+#endif // REDUCTION_H
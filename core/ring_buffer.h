@@ -0,0 +1,90 @@
+#ifndef RINGBUFFER_H
+#define RINGBUFFER_H
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+template <typename T>
+class RingBuffer
+{
+public:
+    explicit RingBuffer(size_t capacity)
+        : values(roundUpToPowerOfTwo(capacity + 1))
+        , mask(values.size() - 1)
+    {
+    }
+
+    RingBuffer(const RingBuffer&) = delete;
+    RingBuffer& operator=(const RingBuffer&) = delete;
+
+    bool push(const T& value)
+    {
+        size_t currentHead = head.load(std::memory_order_relaxed);
+        size_t nextHead = (currentHead + 1) & mask;
+        if (nextHead == tail.load(std::memory_order_acquire))
+        {
+            dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        values[currentHead] = value;
+        head.store(nextHead, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& value)
+    {
+        size_t currentTail = tail.load(std::memory_order_relaxed);
+        if (currentTail == head.load(std::memory_order_acquire))
+            return false;
+
+        value = values[currentTail];
+        tail.store((currentTail + 1) & mask, std::memory_order_release);
+        return true;
+    }
+
+    template <typename Function>
+    size_t drain(Function&& function)
+    {
+        size_t count = 0;
+
+        T value;
+        while (pop(value))
+        {
+            function(value);
+            ++count;
+        }
+
+        return count;
+    }
+
+    size_t capacity() const
+    {
+        return mask;
+    }
+
+    size_t getNumDropped() const
+    {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+private:
+    static size_t roundUpToPowerOfTwo(size_t value)
+    {
+        size_t result = 2;
+        while (result < value)
+            result <<= 1;
+
+        return result;
+    }
+
+    std::vector<T> values;
+    size_t mask;
+
+    alignas(64) std::atomic<size_t> head{0};
+    alignas(64) std::atomic<size_t> tail{0};
+    alignas(64) std::atomic<size_t> dropped{0};
+};
+
+#endif // RINGBUFFER_H
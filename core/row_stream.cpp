@@ -0,0 +1,826 @@
+#include "row_stream.h"
+
+#include "mapped_file.h"
+#include "profiler.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace
+{
+bool isBlank(const std::string& line)
+{
+    return std::all_of(line.begin(), line.end(), [](unsigned char ch) { return std::isspace(ch); });
+}
+
+void parseValues(const std::string& line, std::vector<double>& values)
+{
+    values.clear();
+
+    const char* it = line.data();
+    const char* end = line.data() + line.size();
+    while (true)
+    {
+        while ((it != end) && std::isspace(static_cast<unsigned char>(*it)))
+            ++it;
+        if (it == end)
+            break;
+        if (*it == '+')
+            ++it;
+
+        double value = 0.0;
+        auto [next, error] = std::from_chars(it, end, value);
+        if (error != std::errc())
+            throw std::invalid_argument("Failed to parse the value: " + std::string(it, std::find_if(it, end, [](unsigned char ch) { return std::isspace(ch); })));
+
+        values.push_back(value);
+        it = next;
+    }
+}
+
+class TextRowStream : public MatrixRowStream
+{
+public:
+    explicit TextRowStream(const std::string& filepath)
+        : file(std::make_unique<std::ifstream>(filepath))
+        , input(*file)
+    {
+        if (!file->is_open())
+            throw std::invalid_argument("Failed to open the file: " + filepath);
+
+        readFirstRow();
+    }
+
+    explicit TextRowStream(std::istream& input)
+        : input(input)
+    {
+        readFirstRow();
+    }
+
+    std::optional<size_t> getNumRows() const override
+    {
+        return std::nullopt;
+    }
+
+    size_t getNumColumns() const override
+    {
+        return numColumns;
+    }
+
+protected:
+    bool readNextRow(double* destination) override
+    {
+        if (!hasPendingRow)
+        {
+            if (!readLine())
+                return false;
+
+            if (values.size() != numColumns)
+                throw std::invalid_argument("Inconsistent number of columns in row " + std::to_string(getRowIndex() + 1));
+        }
+
+        hasPendingRow = false;
+        std::copy(values.begin(), values.end(), destination);
+        return true;
+    }
+
+private:
+    void readFirstRow()
+    {
+        hasPendingRow = readLine();
+        numColumns = values.size();
+    }
+
+    bool readLine()
+    {
+        while (std::getline(input, line))
+        {
+            if (isBlank(line))
+                continue;
+
+            parseValues(line, values);
+            return true;
+        }
+
+        return false;
+    }
+
+    std::unique_ptr<std::ifstream> file;
+    std::istream& input;
+
+    std::string line;
+    std::vector<double> values;
+    size_t numColumns = 0;
+    bool hasPendingRow = false;
+};
+
+class NpyRowStream : public MatrixRowStream
+{
+public:
+    explicit NpyRowStream(const std::string& filepath)
+        : file(filepath)
+        , header(npy::parseHeader(file.data(), file.size()))
+    {
+        if (header.shape.size() == 2)
+        {
+            numRows = header.shape[0];
+            numColumns = header.shape[1];
+        }
+        else if (header.shape.size() == 1)
+        {
+            numRows = header.shape[0];
+            numColumns = 1;
+        }
+        else
+        {
+            throw std::invalid_argument("Only 1-D and 2-D arrays can be streamed as a matrix");
+        }
+    }
+
+    std::optional<size_t> getNumRows() const override
+    {
+        return numRows;
+    }
+
+    size_t getNumColumns() const override
+    {
+        return numColumns;
+    }
+
+protected:
+    bool readNextRow(double* destination) override
+    {
+        size_t rowIndex = getRowIndex();
+        if (rowIndex >= numRows)
+            return false;
+
+        const char* values = file.data() + header.dataOffset;
+        size_t itemSize = header.itemSize();
+
+        if (header.order == npy::Order::C)
+        {
+            npy::readValues(values + rowIndex * numColumns * itemSize, header, numColumns, destination);
+        }
+        else
+        {
+            for (size_t columnIndex = 0; columnIndex < numColumns; ++columnIndex)
+                npy::readValues(values + (columnIndex * numRows + rowIndex) * itemSize, header, 1, destination + columnIndex);
+        }
+
+        return true;
+    }
+
+private:
+    MappedFile file;
+    npy::Header header;
+
+    size_t numRows = 0;
+    size_t numColumns = 0;
+};
+
+constexpr size_t SPILL_READ_ENTRIES = 1 << 12;
+constexpr size_t MIN_SPILL_BUFFER_ENTRIES = 64;
+
+struct SpilledEntry
+{
+    size_t rowIndex;
+    size_t columnIndex;
+    double value;
+};
+
+struct FileCloser
+{
+    void operator()(std::FILE* file) const
+    {
+        std::fclose(file);
+    }
+};
+
+void seekSpill(std::FILE* file, uint64_t entryIndex)
+{
+    uint64_t offset = entryIndex * sizeof(SpilledEntry);
+#ifdef _WIN32
+    int result = _fseeki64(file, static_cast<__int64>(offset), SEEK_SET);
+#else
+    int result = fseeko(file, static_cast<off_t>(offset), SEEK_SET);
+#endif
+    if (result != 0)
+        throw std::runtime_error("Failed to seek in the temporary file");
+}
+
+class MatrixMarketRowStream : public MatrixRowStream
+{
+public:
+    MatrixMarketRowStream(const std::string& filepath, size_t bufferLimit)
+        : file(filepath)
+        , bufferLimit(std::max<size_t>(bufferLimit, 1))
+    {
+        if (!file.is_open())
+            throw std::invalid_argument("Failed to open the file: " + filepath);
+
+        readBanner();
+        if (format == Format::Coordinate)
+            countEntries();
+        computeBands();
+    }
+
+    std::optional<size_t> getNumRows() const override
+    {
+        return numRows;
+    }
+
+    size_t getNumColumns() const override
+    {
+        return numColumns;
+    }
+
+protected:
+    bool readNextRow(double* destination) override
+    {
+        size_t rowIndex = getRowIndex();
+        if (rowIndex >= numRows)
+            return false;
+
+        if (rowIndex >= bandEnd)
+            loadNextBand();
+
+        size_t bandRow = rowIndex - bandStart;
+        if (format == Format::Array)
+        {
+            std::copy_n(bandValues.begin() + bandRow * numColumns, numColumns, destination);
+        }
+        else
+        {
+            std::fill_n(destination, numColumns, 0.0);
+            for (size_t k = bandOffsets[bandRow]; k < bandOffsets[bandRow + 1]; ++k)
+                destination[bandColumns[k]] += bandValues[k];
+        }
+
+        return true;
+    }
+
+private:
+    enum class Format
+    {
+        Coordinate,
+        Array
+    };
+
+    enum class Symmetry
+    {
+        General,
+        Symmetric,
+        SkewSymmetric
+    };
+
+    void readBanner()
+    {
+        if (!std::getline(file, line) || (line.rfind("%%MatrixMarket", 0) != 0))
+            throw std::invalid_argument("Invalid Matrix Market file: missing banner");
+
+        std::transform(line.begin(), line.end(), line.begin(), [](unsigned char ch) { return std::tolower(ch); });
+
+        std::istringstream banner(line);
+        std::string magic, object, formatName, field, symmetryName;
+        banner >> magic >> object >> formatName >> field >> symmetryName;
+
+        if (object != "matrix")
+            throw std::invalid_argument("Unsupported Matrix Market object: " + object);
+
+        if (formatName == "coordinate")
+            format = Format::Coordinate;
+        else if (formatName == "array")
+            format = Format::Array;
+        else
+            throw std::invalid_argument("Unsupported Matrix Market format: " + formatName);
+
+        if ((field != "real") && (field != "double") && (field != "integer") && (field != "pattern"))
+            throw std::invalid_argument("Unsupported Matrix Market field: " + field);
+        isPattern = (field == "pattern");
+
+        if (symmetryName == "general")
+            symmetry = Symmetry::General;
+        else if (symmetryName == "symmetric")
+            symmetry = Symmetry::Symmetric;
+        else if (symmetryName == "skew-symmetric")
+            symmetry = Symmetry::SkewSymmetric;
+        else
+            throw std::invalid_argument("Unsupported Matrix Market symmetry: " + symmetryName);
+
+        if (isPattern && (format == Format::Array))
+            throw std::invalid_argument("Invalid Matrix Market file: pattern matrices must use coordinate format");
+
+        if (!readDataLine())
+            throw std::invalid_argument("Invalid Matrix Market file: missing size line");
+
+        size_t expectedValues = (format == Format::Coordinate) ? 3 : 2;
+        if (values.size() != expectedValues)
+            throw std::invalid_argument("Invalid Matrix Market file: malformed size line");
+
+        numRows = static_cast<size_t>(values[0]);
+        numColumns = static_cast<size_t>(values[1]);
+        if (format == Format::Coordinate)
+            numEntries = static_cast<size_t>(values[2]);
+        else if (symmetry == Symmetry::General)
+            numEntries = numRows * numColumns;
+        else if (symmetry == Symmetry::Symmetric)
+            numEntries = numRows * (numRows + 1) / 2;
+        else
+            numEntries = numRows * (numRows - 1) / 2;
+
+        if ((numRows == 0) || (numColumns == 0))
+            throw std::invalid_argument("Invalid Matrix Market file: empty matrix");
+        if ((symmetry != Symmetry::General) && (numRows != numColumns))
+            throw std::invalid_argument("Invalid Matrix Market file: symmetric matrix must be square");
+
+        dataStart = file.tellg();
+    }
+
+    bool readDataLine()
+    {
+        while (std::getline(file, line))
+        {
+            if (isBlank(line) || (line[0] == '%'))
+                continue;
+
+            parseValues(line, values);
+            return true;
+        }
+
+        return false;
+    }
+
+    void rewind()
+    {
+        file.clear();
+        file.seekg(dataStart);
+        arrayRow = (symmetry == Symmetry::SkewSymmetric) ? 1 : 0;
+        arrayColumn = 0;
+    }
+
+    void readEntry(size_t& rowIndex, size_t& columnIndex, double& value)
+    {
+        if (!readDataLine())
+            throw std::invalid_argument("Invalid Matrix Market file: unexpected end of data");
+
+        if (format == Format::Array)
+        {
+            if (values.size() != 1)
+                throw std::invalid_argument("Invalid Matrix Market file: malformed entry");
+
+            rowIndex = arrayRow;
+            columnIndex = arrayColumn;
+            value = values[0];
+
+            if (++arrayRow == numRows)
+            {
+                ++arrayColumn;
+                arrayRow = (symmetry == Symmetry::General) ? 0 : arrayColumn + ((symmetry == Symmetry::SkewSymmetric) ? 1 : 0);
+            }
+            return;
+        }
+
+        if (values.size() != (isPattern ? 2u : 3u))
+            throw std::invalid_argument("Invalid Matrix Market file: malformed entry");
+
+        if ((values[0] < 1) || (values[1] < 1) || (values[0] > numRows) || (values[1] > numColumns))
+            throw std::invalid_argument("Invalid Matrix Market file: entry index is out of range");
+
+        rowIndex = static_cast<size_t>(values[0]) - 1;
+        columnIndex = static_cast<size_t>(values[1]) - 1;
+        value = isPattern ? 1.0 : values[2];
+    }
+
+    void countEntries()
+    {
+        rowCounts.assign(numRows, 0);
+        isRowSorted = (symmetry == Symmetry::General);
+
+        size_t previousRow = 0;
+        for (size_t entry = 0; entry < numEntries; ++entry)
+        {
+            size_t rowIndex = 0, columnIndex = 0;
+            double value = 0.0;
+            readEntry(rowIndex, columnIndex, value);
+
+            ++rowCounts[rowIndex];
+            if ((symmetry != Symmetry::General) && (rowIndex != columnIndex))
+                ++rowCounts[columnIndex];
+
+            isRowSorted = isRowSorted && (rowIndex >= previousRow);
+            previousRow = rowIndex;
+        }
+    }
+
+    // Entries a row receives, mirrored ones included
+    size_t getRowEntries(size_t rowIndex) const
+    {
+        if (format == Format::Coordinate)
+            return rowCounts[rowIndex];
+
+        return (symmetry == Symmetry::SkewSymmetric) ? numColumns - 1 : numColumns;
+    }
+
+    void computeBands()
+    {
+        bandRows.assign(1, 0);
+        bandEntries.clear();
+
+        size_t bufferedEntries = 0;
+        size_t storedEntries = 0;
+        for (size_t row = 0; row < numRows; ++row)
+        {
+            size_t rowEntries = (format == Format::Array) ? numColumns : rowCounts[row];
+            if ((row != bandRows.back()) && (bufferedEntries + rowEntries > bufferLimit))
+            {
+                bandRows.push_back(row);
+                bandEntries.push_back(storedEntries);
+                bufferedEntries = 0;
+                storedEntries = 0;
+            }
+
+            bufferedEntries += rowEntries;
+            storedEntries += getRowEntries(row);
+        }
+
+        bandRows.push_back(numRows);
+        bandEntries.push_back(storedEntries);
+    }
+
+    // The file is parsed once more in total: a single band or row-sorted entries are read in order, any
+    // other layout is first sorted into per-band regions of a temporary file
+    void loadNextBand()
+    {
+        bandStart = bandRows[bandIndex];
+        bandEnd = bandRows[bandIndex + 1];
+
+        if (format == Format::Array)
+        {
+            bandValues.assign((bandEnd - bandStart) * numColumns, 0.0);
+        }
+        else
+        {
+            bandOffsets.assign(bandEnd - bandStart + 1, 0);
+            for (size_t row = bandStart; row < bandEnd; ++row)
+                bandOffsets[row - bandStart + 1] = bandOffsets[row - bandStart] + rowCounts[row];
+
+            bandColumns.resize(bandOffsets.back());
+            bandValues.resize(bandOffsets.back());
+            fillPositions.assign(bandOffsets.begin(), bandOffsets.end() - 1);
+        }
+
+        if (bandEntries.size() == 1)
+        {
+            rewind();
+            for (size_t entry = 0; entry < numEntries; ++entry)
+                readIntoBand();
+        }
+        else if (isRowSorted)
+        {
+            if (bandIndex == 0)
+                rewind();
+            for (size_t entry = 0; entry < bandEntries[bandIndex]; ++entry)
+                readIntoBand();
+        }
+        else
+        {
+            if (!spillFile)
+                spillEntries();
+            readSpilledBand();
+        }
+
+        ++bandIndex;
+    }
+
+    void readIntoBand()
+    {
+        size_t rowIndex = 0, columnIndex = 0;
+        double value = 0.0;
+        readEntry(rowIndex, columnIndex, value);
+
+        storeInBand(rowIndex, columnIndex, value);
+        if ((symmetry != Symmetry::General) && (rowIndex != columnIndex))
+            storeInBand(columnIndex, rowIndex, (symmetry == Symmetry::SkewSymmetric) ? -value : value);
+    }
+
+    void spillEntries()
+    {
+        spillFile.reset(std::tmpfile());
+        if (!spillFile)
+            throw std::runtime_error("Failed to create a temporary file");
+
+        size_t numBands = bandEntries.size();
+        spillStarts.assign(numBands, 0);
+        for (size_t band = 1; band < numBands; ++band)
+            spillStarts[band] = spillStarts[band - 1] + bandEntries[band - 1];
+
+        // The write buffers of all bands together stay within the buffer limit unless it is tiny
+        size_t bufferSize = std::max(bufferLimit / numBands, MIN_SPILL_BUFFER_ENTRIES);
+        std::vector<std::vector<SpilledEntry>> buffers(numBands);
+        std::vector<uint64_t> positions = spillStarts;
+
+        auto spill = [&](size_t rowIndex, size_t columnIndex, double value)
+        {
+            size_t band = std::upper_bound(bandRows.begin(), bandRows.end(), rowIndex) - bandRows.begin() - 1;
+            std::vector<SpilledEntry>& buffer = buffers[band];
+
+            buffer.push_back({ rowIndex, columnIndex, value });
+            if (buffer.size() == bufferSize)
+                flushSpill(buffer, positions[band]);
+        };
+
+        rewind();
+        for (size_t entry = 0; entry < numEntries; ++entry)
+        {
+            size_t rowIndex = 0, columnIndex = 0;
+            double value = 0.0;
+            readEntry(rowIndex, columnIndex, value);
+
+            spill(rowIndex, columnIndex, value);
+            if ((symmetry != Symmetry::General) && (rowIndex != columnIndex))
+                spill(columnIndex, rowIndex, (symmetry == Symmetry::SkewSymmetric) ? -value : value);
+        }
+
+        for (size_t band = 0; band < numBands; ++band)
+            flushSpill(buffers[band], positions[band]);
+    }
+
+    void flushSpill(std::vector<SpilledEntry>& buffer, uint64_t& position)
+    {
+        if (buffer.empty())
+            return;
+
+        seekSpill(spillFile.get(), position);
+        if (std::fwrite(buffer.data(), sizeof(SpilledEntry), buffer.size(), spillFile.get()) != buffer.size())
+            throw std::runtime_error("Failed to write the temporary file");
+
+        position += buffer.size();
+        buffer.clear();
+    }
+
+    void readSpilledBand()
+    {
+        seekSpill(spillFile.get(), spillStarts[bandIndex]);
+
+        std::vector<SpilledEntry> entries(std::min(SPILL_READ_ENTRIES, bandEntries[bandIndex]));
+        for (size_t remaining = bandEntries[bandIndex]; remaining > 0;)
+        {
+            size_t count = std::min(remaining, entries.size());
+            if (std::fread(entries.data(), sizeof(SpilledEntry), count, spillFile.get()) != count)
+                throw std::runtime_error("Failed to read the temporary file");
+
+            for (size_t index = 0; index < count; ++index)
+                storeInBand(entries[index].rowIndex, entries[index].columnIndex, entries[index].value);
+            remaining -= count;
+        }
+    }
+
+    void storeInBand(size_t rowIndex, size_t columnIndex, double value)
+    {
+        if ((rowIndex < bandStart) || (rowIndex >= bandEnd))
+            return;
+
+        size_t bandRow = rowIndex - bandStart;
+        if (format == Format::Array)
+        {
+            bandValues[bandRow * numColumns + columnIndex] = value;
+        }
+        else
+        {
+            size_t position = fillPositions[bandRow]++;
+            bandColumns[position] = columnIndex;
+            bandValues[position] = value;
+        }
+    }
+
+    std::ifstream file;
+    std::streampos dataStart;
+    size_t bufferLimit;
+
+    Format format = Format::Coordinate;
+    Symmetry symmetry = Symmetry::General;
+    bool isPattern = false;
+
+    size_t numRows = 0;
+    size_t numColumns = 0;
+    size_t numEntries = 0;
+    size_t arrayRow = 0;
+    size_t arrayColumn = 0;
+
+    std::vector<size_t> rowCounts;
+    bool isRowSorted = false;
+
+    std::vector<size_t> bandRows;
+    std::vector<size_t> bandEntries;
+    size_t bandIndex = 0;
+    size_t bandStart = 0;
+    size_t bandEnd = 0;
+    std::vector<size_t> bandOffsets;
+    std::vector<size_t> fillPositions;
+    std::vector<size_t> bandColumns;
+    std::vector<double> bandValues;
+
+    std::unique_ptr<std::FILE, FileCloser> spillFile;
+    std::vector<uint64_t> spillStarts;
+
+    std::string line;
+    std::vector<double> values;
+};
+}
+
+const double* RowBlock::row(size_t index) const
+{
+    if (index >= numRows)
+        throw std::out_of_range("Row block index is out of range");
+
+    return values.data() + index * numColumns;
+}
+
+std::unique_ptr<MatrixRowStream> MatrixRowStream::open(const std::string& filepath, size_t bufferLimit /*= DEFAULT_BUFFER_LIMIT*/)
+{
+    if (!std::filesystem::exists(filepath))
+        throw std::invalid_argument("Failed to open the file: " + filepath);
+
+    auto extension = std::filesystem::path(filepath).extension();
+    if (extension == ".npy")
+        return std::make_unique<NpyRowStream>(filepath);
+    if (extension == ".mtx")
+        return std::make_unique<MatrixMarketRowStream>(filepath, bufferLimit);
+
+    return std::make_unique<TextRowStream>(filepath);
+}
+
+std::unique_ptr<MatrixRowStream> MatrixRowStream::open(std::istream& input)
+{
+    return std::make_unique<TextRowStream>(input);
+}
+
+size_t MatrixRowStream::getRowIndex() const
+{
+    return rowIndex;
+}
+
+bool MatrixRowStream::readRow(std::vector<double>& row)
+{
+    row.resize(getNumColumns());
+    if (!readNextRow(row.data()))
+        return false;
+
+    ++rowIndex;
+    return true;
+}
+
+bool MatrixRowStream::readBlock(RowBlock& block, size_t maxRows)
+{
+    PROFILE_SCOPE("read_chunk");
+    size_t numColumns = getNumColumns();
+
+    block.firstRow = rowIndex;
+    block.numRows = 0;
+    block.numColumns = numColumns;
+    if (block.values.size() < maxRows * numColumns)
+        block.values.resize(maxRows * numColumns);
+
+    while ((block.numRows < maxRows) && readNextRow(block.values.data() + block.numRows * numColumns))
+    {
+        ++block.numRows;
+        ++rowIndex;
+    }
+
+    return block.numRows > 0;
+}
+
+namespace streaming
+{
+double calculateEuclidianNorm(MatrixRowStream& stream)
+{
+    double norm = 0.0;
+
+    std::vector<double> row;
+    while (stream.readRow(row))
+        for (double value : row)
+            norm += value * value;
+
+    return std::sqrt(norm);
+}
+
+RowStatistics calculateStatistics(MatrixRowStream& stream)
+{
+    RowStatistics statistics;
+    statistics.numColumns = stream.getNumColumns();
+    statistics.min = std::numeric_limits<double>::infinity();
+    statistics.max = -std::numeric_limits<double>::infinity();
+
+    double sum = 0.0;
+    double squaresSum = 0.0;
+
+    std::vector<double> row;
+    while (stream.readRow(row))
+    {
+        for (double value : row)
+        {
+            statistics.min = std::min(statistics.min, value);
+            statistics.max = std::max(statistics.max, value);
+            statistics.numNonZeros += (value != 0.0) ? 1 : 0;
+            sum += value;
+            squaresSum += value * value;
+        }
+        ++statistics.numRows;
+    }
+
+    size_t numElements = statistics.numRows * statistics.numColumns;
+    if (numElements == 0)
+    {
+        statistics.min = 0.0;
+        statistics.max = 0.0;
+    }
+    else
+    {
+        statistics.mean = sum / numElements;
+    }
+    statistics.euclidianNorm = std::sqrt(squaresSum);
+
+    return statistics;
+}
+
+Vector multiply(MatrixRowStream& stream, const Vector& vector)
+{
+    if (vector.size() != stream.getNumColumns())
+        throw std::invalid_argument("Can't multiply matrix and vector with given sizes");
+
+    Vector result;
+
+    std::vector<double> row;
+    while (stream.readRow(row))
+    {
+        double sum = 0.0;
+        for (size_t index = 0; index < row.size(); ++index)
+            sum += row[index] * vector[index];
+
+        result.pushBack(sum);
+    }
+
+    return result;
+}
+
+void convertToNpy(MatrixRowStream& stream, const std::string& filepath, npy::DataType type /*= npy::DataType::Float64*/)
+{
+    std::ofstream file(filepath, std::ios_base::binary | std::ios_base::trunc);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to create a file: " + filepath);
+
+    size_t numColumns = stream.getNumColumns();
+
+    std::ostringstream reserved;
+    npy::writeHeader(reserved, type, npy::Order::C, { std::numeric_limits<size_t>::max(), numColumns });
+    size_t headerLength = reserved.str().size();
+
+    npy::writeHeader(file, type, npy::Order::C, { 0, numColumns }, headerLength);
+
+    size_t numRows = 0;
+    std::vector<double> row;
+    while (stream.readRow(row))
+    {
+        npy::writeValues(file, row.data(), row.size(), type);
+        ++numRows;
+    }
+
+    file.seekp(0);
+    npy::writeHeader(file, type, npy::Order::C, { numRows, numColumns }, headerLength);
+
+    if (!file)
+        throw std::runtime_error("Failed to write the file: " + filepath);
+}
+
+void convertToText(MatrixRowStream& stream, const std::string& filepath)
+{
+    std::ofstream file(filepath, std::ios_base::trunc);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to create a file: " + filepath);
+
+    file.precision(std::numeric_limits<double>::max_digits10);
+
+    std::vector<double> row;
+    while (stream.readRow(row))
+    {
+        for (size_t index = 0; index < row.size(); ++index)
+        {
+            file << row[index];
+            if (index != (row.size() - 1))
+                file << ' ';
+        }
+        file << '\n';
+    }
+
+    if (!file)
+        throw std::runtime_error("Failed to write the file: " + filepath);
+}
+}
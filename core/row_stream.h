@@ -0,0 +1,68 @@
+#ifndef ROWSTREAM_H
+#define ROWSTREAM_H
+
+#include "vector.h"
+#include "npy.h"
+
+#include <istream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+struct RowBlock
+{
+    size_t firstRow = 0;
+    size_t numRows = 0;
+    size_t numColumns = 0;
+    std::vector<double> values;
+
+    const double* row(size_t index) const;
+};
+
+struct RowStatistics
+{
+    size_t numRows = 0;
+    size_t numColumns = 0;
+    size_t numNonZeros = 0;
+    double min = 0.0;
+    double max = 0.0;
+    double mean = 0.0;
+    double euclidianNorm = 0.0;
+};
+
+class MatrixRowStream
+{
+public:
+    static constexpr size_t DEFAULT_BUFFER_LIMIT = size_t(1) << 22;
+
+    virtual ~MatrixRowStream() = default;
+
+    static std::unique_ptr<MatrixRowStream> open(const std::string& filepath, size_t bufferLimit = DEFAULT_BUFFER_LIMIT);
+    static std::unique_ptr<MatrixRowStream> open(std::istream& input);
+
+    virtual std::optional<size_t> getNumRows() const = 0;
+    virtual size_t getNumColumns() const = 0;
+    size_t getRowIndex() const;
+
+    bool readRow(std::vector<double>& row);
+    bool readBlock(RowBlock& block, size_t maxRows);
+
+protected:
+    virtual bool readNextRow(double* destination) = 0;
+
+private:
+    size_t rowIndex = 0;
+};
+
+namespace streaming
+{
+double calculateEuclidianNorm(MatrixRowStream& stream);
+RowStatistics calculateStatistics(MatrixRowStream& stream);
+Vector multiply(MatrixRowStream& stream, const Vector& vector);
+
+void convertToNpy(MatrixRowStream& stream, const std::string& filepath, npy::DataType type = npy::DataType::Float64);
+void convertToText(MatrixRowStream& stream, const std::string& filepath);
+}
+
+#endif // ROWSTREAM_H
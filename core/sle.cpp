@@ -0,0 +1,562 @@
+#include "sle.h"
+
+#include "profiler.h"
+#include "reduction.h"
+#include "solver_workspace.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <numeric>
+#include <fstream>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+constexpr double EPS = 1e-6;
+constexpr size_t ELEMENTS_PER_TASK = 1 << 14;
+
+size_t getRowGrain(size_t numColumns)
+{
+    return std::max<size_t>(ELEMENTS_PER_TASK / std::max<size_t>(numColumns, 1), 1);
+}
+
+void reportProgress(const CancellationToken* token, const ProgressCallback& progress, SolverStage stage, size_t step, size_t numSteps, double residual = 0.0)
+{
+    if (token)
+        token->throwIfCancelled();
+
+    if (progress)
+        progress({ stage, step, numSteps, residual });
+}
+
+enum class SLESolutionType
+{
+    SolitionExists,
+    NoSolution,
+    InfiniteSolutions
+};
+
+SLESolutionType getSLESolutionType(const Matrix& A, const Matrix& B)
+{
+    for (size_t i = 0; i < A.getNumRows(); ++i)
+    {
+        bool allZeros = true;
+        for (size_t j = 0; j < A.getNumColumns(); ++j)
+        {
+            if (std::abs(A[i][j]) >= EPS)
+            {
+                allZeros = false;
+                break;
+            }
+        }
+
+        if (allZeros && std::abs(B[i][0]) >= EPS)
+            return SLESolutionType::NoSolution;
+        else if (allZeros && std::abs(B[i][0]) <= EPS)
+            return SLESolutionType::InfiniteSolutions;
+    }
+
+    return SLESolutionType::SolitionExists;
+}
+
+Matrix getMatrixT(const Matrix& matrix, int k)
+{
+    Matrix T(matrix.getNumRows(), matrix.getNumColumns());
+
+    for (int i = 0; i < T.getNumRows(); ++i)
+        T[i][i] = 1;
+
+    T[k][k] = 1.0 / matrix[k][k];
+
+    for (int i = (k + 1); i < T.getNumRows(); ++i)
+        T[i][k] = -matrix[i][k] / matrix[k][k];
+
+    return T;
+}
+
+void getEchelonForm(Matrix& A, Matrix& B, std::ostream* output = nullptr, const CancellationToken* token = nullptr, const ProgressCallback& progress = nullptr)
+{
+    PROFILE_SCOPE("elimination");
+
+    for (size_t k = 0; k < A.getNumRows(); ++k)
+    {
+        reportProgress(token, progress, SolverStage::Elimination, k, A.getNumRows());
+        PROFILE_ITERATIONS(1);
+
+        size_t maxElementIndex = k;
+
+        for (size_t i = k + 1; i < A.getNumRows(); ++i)
+        {
+            if (std::abs(A[i][k]) > std::abs(A[maxElementIndex][k]))
+                maxElementIndex = i;
+        }
+
+        std::swap(A[k], A[maxElementIndex]);
+        std::swap(B[k], B[maxElementIndex]);
+
+        if (std::abs(A[k][k]) < EPS) {
+            continue;
+        }
+
+        [[maybe_unused]] uint64_t numUpdatedRows = A.getNumRows() - k - 1;
+        uint64_t numUpdatedColumns = A.getNumRows() - k;
+        PROFILE_FLOPS(numUpdatedRows * (2 * numUpdatedColumns + 3));
+        PROFILE_BYTES(numUpdatedRows * (2 * numUpdatedColumns + 3) * sizeof(double));
+
+        const double* pivotRow = A[k].begin();
+        double pivotRhs = B[k][0];
+        size_t numColumns = A.getNumRows();
+
+        parallelFor(k + 1, A.getNumRows(), getRowGrain(numUpdatedColumns), [&](size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i)
+            {
+                double* row = A[i].begin();
+                double factor = row[k] / pivotRow[k];
+
+                B[i][0] = B[i][0] - factor * pivotRhs;
+                for (size_t j = k; j < numColumns; ++j)
+                    row[j] = row[j] - factor * pivotRow[j];
+            }
+        });
+
+        if (output)
+        {
+            PROFILE_SCOPE("trace");
+            *output << "Iteration " << k + 1 << ":\n";
+            *output << "U(" << k + 1 << ") = \n" << A;
+            *output << "C(" << k + 1 << ") = \n" << B << std::endl;
+        }
+    }
+}
+
+Matrix getMatrixV(const Matrix& matrix, int k)
+{
+    Matrix V = matrix;
+
+    for (int i = 0; i < V.getNumRows(); ++i)
+        V[i][i] = 1;
+
+    V[k][k] = 1.0 / matrix[k][k];
+
+    for (int i = 0; i < k; ++i)
+        V[i][k] = -matrix[i][k];
+
+    return V;
+}
+
+void getSolution(const Matrix& U, Matrix& C, Vector& solution, std::ostream* output = nullptr, const CancellationToken* token = nullptr, const ProgressCallback& progress = nullptr)
+{
+    PROFILE_SCOPE("back_substitution");
+
+    for (int i = U.getNumRows() - 1; i >= 0; i--)
+    {
+        reportProgress(token, progress, SolverStage::BackSubstitution, U.getNumRows() - 1 - i, U.getNumRows());
+        PROFILE_ITERATIONS(1);
+        PROFILE_FLOPS(2 * static_cast<uint64_t>(i) + 1);
+        PROFILE_BYTES((2 * static_cast<uint64_t>(i) + 2) * sizeof(double));
+
+        solution[i] = C[i][0] / U[i][i];
+        for (int j = i - 1; j >= 0; j--) {
+            C[j][0] -= U[j][i] * solution[i];
+        }
+
+        if (output)
+        {
+            PROFILE_SCOPE("trace");
+            *output << "Iteration (" << U.getNumRows() - i << "):\n";
+            *output << C << std::endl;
+        }
+    }
+}
+
+// Same values as (A * x) - B, written into error
+void calculateError(const Matrix& A, const Matrix& B, const Matrix& x, Matrix& error)
+{
+    parallelFor(0, A.getNumRows(), getRowGrain(A.getNumColumns() * x.getNumColumns()), [&](size_t first, size_t last)
+    {
+        for (size_t i = first; i < last; ++i)
+        {
+            const Vector& row = A[i];
+            for (size_t j = 0; j < x.getNumColumns(); ++j)
+            {
+                double sum = 0.0;
+                for (size_t k = 0; k < row.size(); ++k)
+                    sum += row[k] * x[k][j];
+
+                error[i][j] = sum - B[i][j];
+            }
+        }
+    });
+}
+
+double calculateRelativeError(const Matrix& error, const Matrix& B)
+{
+    return error.calculateEuclidianNorm() / B.calculateEuclidianNorm();
+}
+
+void copySolution(const Vector& x, Matrix& solution)
+{
+    for (size_t i = 0; i < x.size(); ++i)
+        solution[i][0] = x[i];
+}
+}
+
+void CancellationToken::cancel()
+{
+    cancelled = true;
+}
+
+bool CancellationToken::isCancelled() const
+{
+    return cancelled;
+}
+
+void CancellationToken::throwIfCancelled() const
+{
+    if (cancelled)
+        throw SolveCancelled();
+}
+
+SolveCancelled::SolveCancelled()
+    : std::runtime_error("The solution was cancelled")
+{
+}
+
+SLE::SLE()
+{
+}
+
+void SLE::setMatrixA(const Matrix &matrix)
+{
+    A = std::make_unique<Matrix>(matrix);
+}
+
+void SLE::setMatrixA(Matrix&& matrix)
+{
+    A = std::make_unique<Matrix>(std::move(matrix));
+}
+
+const Matrix& SLE::getMatrixA() const
+{
+    if (!A.get())
+        throw std::runtime_error("Matrix A does not exist");
+
+    return *A;
+}
+
+Matrix &SLE::getMatrixA()
+{
+    if (!A.get())
+        throw std::runtime_error("Matrix A does not exist");
+
+    return *A;
+}
+
+Matrix SLE::takeMatrixA()
+{
+    if (!A.get())
+        throw std::runtime_error("Matrix A does not exist");
+
+    Matrix taken = std::move(*A);
+    A.reset();
+
+    return taken;
+}
+
+void SLE::setMatrixB(const Matrix &matrix)
+{
+    B = std::make_unique<Matrix>(matrix);
+}
+
+void SLE::setMatrixB(Matrix&& matrix)
+{
+    B = std::make_unique<Matrix>(std::move(matrix));
+}
+
+const Matrix& SLE::getMatrixB() const
+{
+    if (!B.get())
+        throw std::runtime_error("Matrix B does not exist");
+
+    return *B;
+}
+
+Matrix &SLE::getMatrixB()
+{
+    if (!B.get())
+        throw std::runtime_error("Matrix B does not exist");
+
+    return *B;
+}
+
+Matrix SLE::takeMatrixB()
+{
+    if (!B.get())
+        throw std::runtime_error("Matrix B does not exist");
+
+    Matrix taken = std::move(*B);
+    B.reset();
+
+    return taken;
+}
+
+const Vector& SLE::getVectorX() const
+{
+    if (!x.get())
+        throw std::runtime_error("Vector x does not exist");
+
+    return *x;
+}
+
+Vector &SLE::getVectorX()
+{
+    if (!x.get())
+        throw std::runtime_error("Vector x does not exist");
+
+    return *x;
+}
+
+Vector SLE::takeVectorX()
+{
+    if (!x.get())
+        throw std::runtime_error("Vector x does not exist");
+
+    Vector taken = std::move(*x);
+    x.reset();
+
+    return taken;
+}
+
+void SLE::setOptions(const SolverOptions& options)
+{
+    if (options.tolerance <= 0.0)
+        throw std::invalid_argument("The tolerance should be positive");
+    if (options.maxIterations == 0)
+        throw std::invalid_argument("The maximum number of iterations should be positive");
+
+    this->options = options;
+}
+
+const SolverOptions& SLE::getOptions() const
+{
+    return options;
+}
+
+size_t SLE::getNumIterations() const
+{
+    return numIterations;
+}
+
+const profiler::Profile& SLE::getProfile() const
+{
+    return profile;
+}
+
+void SLE::solveGaussianElimination(const CancellationToken* token /*= nullptr*/, const ProgressCallback& progress /*= nullptr*/)
+{
+    if (!A.get())
+        throw std::runtime_error("Matrix A does not exist");
+    if (!B.get())
+        throw std::runtime_error("Matrix B does not exist");
+    if (B->getNumColumns() != 1)
+        throw std::runtime_error("Wrong size of B matrix, matrix B should have only 1 column");
+    if (A->getNumRows() != B->getNumRows())
+        throw std::runtime_error("Matrices A and B should have the same number of rows");
+
+    profile.clear();
+    PROFILE_SESSION(profile);
+    PROFILE_SCOPE("solve_gaussian_elimination");
+
+    std::ofstream output;
+    if (!options.reportPath.empty())
+        output.open(options.reportPath, std::ios_base::trunc);
+    std::ostream* report = output.is_open() ? &output : nullptr;
+
+    A->adviseAccess(AccessPattern::Sequential);
+    numIterations = 0;
+
+    Matrix& U = options.factorInPlace ? *A : workspace.copyMatrix(WorkspaceSlot::Echelon, *A);
+    Matrix& C = options.factorInPlace ? *B : workspace.copyMatrix(WorkspaceSlot::EchelonRhs, *B);
+
+    getEchelonForm(U, C, report, token, progress);
+
+    auto solutionType = getSLESolutionType(U, C);
+    if (solutionType == SLESolutionType::NoSolution)
+        throw std::runtime_error("SLE has no solution");
+    else if (solutionType == SLESolutionType::InfiniteSolutions)
+        throw std::runtime_error("SLE has infinetly many solution");
+
+    if (!x || (x->size() != U.getNumRows()))
+        x = std::make_unique<Vector>(U.getNumRows());
+
+    getSolution(U, C, *x, report, token, progress);
+    if (!report)
+        return;
+
+    Matrix& solution = workspace.getMatrix(WorkspaceSlot::SolutionColumn, x->size(), 1);
+    copySolution(*x, solution);
+
+    if (options.factorInPlace)
+    {
+        PROFILE_SCOPE("trace");
+        output << "Solution: \n";
+        output << solution << std::endl;
+        return;
+    }
+
+    if (token)
+        token->throwIfCancelled();
+
+    size_t size = A->getNumRows();
+    Matrix& inverse = workspace.getMatrix(WorkspaceSlot::Inverse, size, size);
+    Matrix& error = workspace.getMatrix(WorkspaceSlot::Error, size, 1);
+    double relativeError = 0.0;
+    {
+        PROFILE_SCOPE("diagnostics");
+        A->calculateInverse(inverse, workspace);
+        A->caclulateLUDecomposition(workspace.getMatrix(WorkspaceSlot::Lower, size, size), workspace.getMatrix(WorkspaceSlot::Upper, size, size));
+        calculateError(*A, *B, solution, error);
+        relativeError = calculateRelativeError(error, *B);
+    }
+
+    const Matrix& lower = workspace.getMatrix(WorkspaceSlot::Lower);
+    const Matrix& upper = workspace.getMatrix(WorkspaceSlot::Upper);
+
+    PROFILE_SCOPE("trace");
+
+    output << "LU decomposition:\n";
+    output << lower << '\n' << upper << std::endl;
+
+    output << "Inverse:\n";
+    output << inverse << std::endl;
+
+    output << "Solution: \n";
+    output << solution << std::endl;
+    output << "Error:\n" << error << std::endl;
+    output << "Relative error: " << relativeError;
+}
+
+void SLE::solveGaussSeidelMethod(const CancellationToken* token /*= nullptr*/, const ProgressCallback& progress /*= nullptr*/)
+{
+    if (!A.get())
+        throw std::runtime_error("Matrix A does not exist");
+    if (!B.get())
+        throw std::runtime_error("Matrix B does not exist");
+
+    profile.clear();
+    PROFILE_SESSION(profile);
+    PROFILE_SCOPE("solve_gauss_seidel");
+
+    std::ofstream output;
+    if (!options.reportPath.empty())
+        output.open(options.reportPath, std::ios_base::trunc);
+    std::ostream* report = output.is_open() ? &output : nullptr;
+
+    numIterations = 0;
+
+    Matrix& U = workspace.copyMatrix(WorkspaceSlot::Echelon, *A);
+    Matrix& C = workspace.copyMatrix(WorkspaceSlot::EchelonRhs, *B);
+
+    getEchelonForm(U, C, report, token, progress);
+
+    auto solutionType = getSLESolutionType(U, C);
+    if (solutionType == SLESolutionType::NoSolution)
+        throw std::runtime_error("SLE has no solution");
+    else if (solutionType == SLESolutionType::InfiniteSolutions)
+        throw std::runtime_error("SLE has infinetly many solution");
+
+    if (!x || (x->size() != A->getNumRows()))
+        x = std::make_unique<Vector>(A->getNumRows(), 5.0);
+    else
+        std::fill(x->begin(), x->end(), 5.0);
+
+    const Matrix& a = *A;
+    const Matrix& b = *B;
+    a.adviseAccess(AccessPattern::Sequential);
+
+    size_t iteration = 0;
+    double residual = std::numeric_limits<double>::max();
+
+    uint64_t size = a.getNumRows();
+
+    while ((residual > options.tolerance) && (iteration < options.maxIterations))
+    {
+        {
+            PROFILE_SCOPE("sweep");
+            PROFILE_ITERATIONS(1);
+            PROFILE_FLOPS(size * (2 * size));
+            PROFILE_BYTES(size * (2 * size + 2) * sizeof(double));
+
+            for (int i = 0; i < a.getNumRows(); i++)
+            {
+                double sum = 0.0;
+                for (int j = 0; j < a.getNumRows(); j++)
+                    if (j != i)
+                        sum += a.at(i, j) * x->at(j);
+
+                x->at(i) = (b.at(i, 0) - sum) / a.at(i, i);
+            }
+        }
+
+        {
+            PROFILE_SCOPE("residual");
+            PROFILE_FLOPS(size * (2 * size + 3) + 1);
+            PROFILE_BYTES(size * (2 * size + 1) * sizeof(double));
+
+            const Vector& solution = *x;
+            residual = std::sqrt(parallelSum(0, size, getRowGrain(size), [&](size_t first, size_t last)
+            {
+                double squares = 0.0;
+                for (size_t i = first; i < last; i++)
+                {
+                    double sum = 0.0;
+                    for (size_t j = 0; j < size; j++)
+                        sum += a.at(i, j) * solution.at(j);
+
+                    squares += std::pow(b.at(i, 0) - sum, 2);
+                }
+
+                return squares;
+            }));
+        }
+
+        iteration++;
+        numIterations = iteration;
+        reportProgress(token, progress, SolverStage::Iteration, iteration, options.maxIterations, residual);
+
+        if (report)
+        {
+            PROFILE_SCOPE("trace");
+            *report << "Iteration (" << iteration << "):\n";
+            for (size_t i = 0; i < x->size(); ++i)
+                *report << x->at(i) << ' ';
+            *report << std::endl << residual << std::endl;
+            *report << std::endl << std::endl;
+        }
+    }
+
+    if (residual > options.tolerance)
+        throw std::runtime_error("Max iterations number reached");
+    if (!report)
+        return;
+
+    Matrix& solution = workspace.getMatrix(WorkspaceSlot::SolutionColumn, x->size(), 1);
+    copySolution(*x, solution);
+
+    Matrix& error = workspace.getMatrix(WorkspaceSlot::Error, A->getNumRows(), 1);
+    double relativeError = 0.0;
+    {
+        PROFILE_SCOPE("diagnostics");
+        calculateError(*A, *B, solution, error);
+        relativeError = calculateRelativeError(error, *B);
+    }
+
+    PROFILE_SCOPE("trace");
+
+    output << "Solution: \n";
+    output << solution << std::endl;
+    output << "Error:\n" << error << std::endl;
+    output << "Relative error: " << relativeError;
+}
@@ -0,0 +1,99 @@
+#ifndef SLE_H
+#define SLE_H
+
+#include "matrix.h"
+#include "vector.h"
+#include "profiler.h"
+#include "solver_workspace.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+class CancellationToken
+{
+public:
+    void cancel();
+    bool isCancelled() const;
+    void throwIfCancelled() const;
+
+private:
+    std::atomic<bool> cancelled{false};
+};
+
+class SolveCancelled : public std::runtime_error
+{
+public:
+    SolveCancelled();
+};
+
+enum class SolverStage
+{
+    Elimination,
+    BackSubstitution,
+    Iteration
+};
+
+struct SolverProgress
+{
+    SolverStage stage = SolverStage::Elimination;
+    size_t step = 0;
+    size_t numSteps = 0;
+    double residual = 0.0;
+};
+
+using ProgressCallback = std::function<void(const SolverProgress&)>;
+
+struct SolverOptions
+{
+    double tolerance = 1e-6;
+    size_t maxIterations = 10000;
+    std::string reportPath = "last_solution.txt";
+    // Gaussian elimination overwrites A and B with the echelon form instead of copying them
+    bool factorInPlace = false;
+};
+
+class SLE
+{
+public:
+    SLE();
+    SLE(const Matrix& A, const Matrix& B, const Vector& x);
+
+    void setMatrixA(const Matrix& matrix);
+    void setMatrixA(Matrix&& matrix);
+    const Matrix& getMatrixA() const;
+    Matrix& getMatrixA();
+    Matrix takeMatrixA();
+
+    void setMatrixB(const Matrix& matrix);
+    void setMatrixB(Matrix&& matrix);
+    const Matrix& getMatrixB() const;
+    Matrix& getMatrixB();
+    Matrix takeMatrixB();
+
+    const Vector& getVectorX() const;
+    Vector& getVectorX();
+    Vector takeVectorX();
+
+    void setOptions(const SolverOptions& options);
+    const SolverOptions& getOptions() const;
+    size_t getNumIterations() const;
+    const profiler::Profile& getProfile() const;
+
+    void solveGaussianElimination(const CancellationToken* token = nullptr, const ProgressCallback& progress = nullptr);
+    void solveGaussSeidelMethod(const CancellationToken* token = nullptr, const ProgressCallback& progress = nullptr);
+
+private:
+    std::unique_ptr<Matrix> A;
+    std::unique_ptr<Matrix> B;
+    std::unique_ptr<Vector> x;
+
+    SolverOptions options;
+    size_t numIterations = 0;
+    profiler::Profile profile;
+    SolverWorkspace workspace;
+};
+
+#endif // SLE_H
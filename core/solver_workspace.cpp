@@ -0,0 +1,31 @@
+#include "solver_workspace.h"
+
+#include "profiler.h"
+
+Matrix& SolverWorkspace::getMatrix(WorkspaceSlot slot, size_t numRows, size_t numColumns)
+{
+    Matrix& matrix = matrices[static_cast<size_t>(slot)];
+    matrix.reset(static_cast<int>(numRows), static_cast<int>(numColumns));
+    return matrix;
+}
+
+Matrix& SolverWorkspace::copyMatrix(WorkspaceSlot slot, const Matrix& source)
+{
+    PROFILE_SCOPE("copy");
+    PROFILE_BYTES(2 * source.getNumRows() * source.getNumColumns() * sizeof(double));
+
+    Matrix& matrix = matrices[static_cast<size_t>(slot)];
+    matrix = source;
+    return matrix;
+}
+
+const Matrix& SolverWorkspace::getMatrix(WorkspaceSlot slot) const
+{
+    return matrices[static_cast<size_t>(slot)];
+}
+
+void SolverWorkspace::clear()
+{
+    for (Matrix& matrix : matrices)
+        matrix = Matrix();
+}
@@ -0,0 +1,42 @@
+#ifndef SOLVERWORKSPACE_H
+#define SOLVERWORKSPACE_H
+
+#include "matrix.h"
+#include "vector.h"
+
+#include <array>
+#include <cstddef>
+
+enum class WorkspaceSlot
+{
+    Echelon,
+    EchelonRhs,
+    Lower,
+    Upper,
+    ForwardSubstitution,
+    Inverse,
+    SolutionColumn,
+    Error
+};
+
+constexpr size_t NUM_WORKSPACE_SLOTS = 8;
+
+// Scratch matrices that outlive a single solve. A slot keeps its storage between calls,
+// so once every slot has seen its shape, repeated solves of that size do not allocate.
+class SolverWorkspace
+{
+public:
+    // Zero-filled matrix of the given shape
+    Matrix& getMatrix(WorkspaceSlot slot, size_t numRows, size_t numColumns);
+    // Copy of source
+    Matrix& copyMatrix(WorkspaceSlot slot, const Matrix& source);
+    // Contents left by the last user of the slot
+    const Matrix& getMatrix(WorkspaceSlot slot) const;
+
+    void clear();
+
+private:
+    std::array<Matrix, NUM_WORKSPACE_SLOTS> matrices;
+};
+
+#endif // SOLVERWORKSPACE_H
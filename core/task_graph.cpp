@@ -0,0 +1,142 @@
+#include "task_graph.h"
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <utility>
+
+void TaskGraph::add(int priority, const std::vector<Dependency>& dependencies, Task task)
+{
+    size_t index = nodes.size();
+
+    std::vector<size_t> predecessors;
+    for (const Dependency& dependency : dependencies)
+    {
+        DataState& state = states[dependency.key];
+
+        if (state.lastWriter != NO_TASK)
+            predecessors.push_back(state.lastWriter);
+
+        if (dependency.access == DataAccess::Read)
+        {
+            state.readers.push_back(index);
+        }
+        else
+        {
+            predecessors.insert(predecessors.end(), state.readers.begin(), state.readers.end());
+            state.readers.clear();
+            state.lastWriter = index;
+        }
+    }
+
+    std::sort(predecessors.begin(), predecessors.end());
+    predecessors.erase(std::unique(predecessors.begin(), predecessors.end()), predecessors.end());
+    predecessors.erase(std::remove(predecessors.begin(), predecessors.end(), index), predecessors.end());
+
+    for (size_t predecessor : predecessors)
+        nodes[predecessor].successors.push_back(index);
+
+    nodes.push_back({ std::move(task), priority, predecessors.size(), {} });
+    numEdges += predecessors.size();
+}
+
+size_t TaskGraph::getNumTasks() const
+{
+    return nodes.size();
+}
+
+size_t TaskGraph::getNumEdges() const
+{
+    return numEdges;
+}
+
+void TaskGraph::run()
+{
+    run(ThreadPool::getInstance());
+}
+
+void TaskGraph::run(ThreadPool& pool)
+{
+    if (nodes.empty())
+        return;
+
+    // Ready tasks are ordered by priority, then by submission order, so the critical path runs first and ties keep program order.
+    auto compare = [this](size_t lhs, size_t rhs)
+    {
+        if (nodes[lhs].priority != nodes[rhs].priority)
+            return nodes[lhs].priority < nodes[rhs].priority;
+
+        return lhs > rhs;
+    };
+
+    std::priority_queue<size_t, std::vector<size_t>, decltype(compare)> ready(compare);
+    std::vector<size_t> numWaiting(nodes.size());
+    for (size_t index = 0; index < nodes.size(); ++index)
+    {
+        numWaiting[index] = nodes[index].numPredecessors;
+        if (numWaiting[index] == 0)
+            ready.push(index);
+    }
+
+    std::mutex mutex;
+    std::exception_ptr error;
+    bool isParallel = pool.getNumThreads() > 1;
+    ThreadPool::TaskGroup group(pool);
+
+    // Runs ready tasks until there are none and never waits for others, so a task that uses the pool
+    // itself can't block the graph. Tasks released beyond the first get their own call on the pool.
+    std::function<void()> execute;
+    execute = [&]()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        while (!ready.empty() && !error)
+        {
+            size_t index = ready.top();
+            ready.pop();
+            lock.unlock();
+
+            try
+            {
+                nodes[index].task();
+            }
+            catch (...)
+            {
+                lock.lock();
+                if (!error)
+                    error = std::current_exception();
+                return;
+            }
+
+            lock.lock();
+            size_t numReleased = 0;
+            for (size_t successor : nodes[index].successors)
+            {
+                if (--numWaiting[successor] == 0)
+                {
+                    ready.push(successor);
+                    ++numReleased;
+                }
+            }
+
+            if (isParallel && (numReleased > 1))
+            {
+                lock.unlock();
+                for (size_t released = 1; released < numReleased; ++released)
+                    group.run(execute);
+                lock.lock();
+            }
+        }
+    };
+
+    size_t numStarted = isParallel ? std::min(ready.size(), pool.getNumThreads()) : 1;
+    for (size_t index = 1; index < numStarted; ++index)
+        group.run(execute);
+
+    execute();
+    group.wait();
+
+    if (error)
+        std::rethrow_exception(error);
+}
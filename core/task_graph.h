@@ -0,0 +1,59 @@
+#ifndef TASKGRAPH_H
+#define TASKGRAPH_H
+
+#include "thread_pool.h"
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+enum class DataAccess
+{
+    Read,
+    Write
+};
+
+class TaskGraph
+{
+public:
+    using Task = std::function<void()>;
+
+    struct Dependency
+    {
+        size_t key;
+        DataAccess access;
+    };
+
+    void add(int priority, const std::vector<Dependency>& dependencies, Task task);
+
+    size_t getNumTasks() const;
+    size_t getNumEdges() const;
+
+    void run(ThreadPool& pool);
+    void run();
+
+private:
+    static constexpr size_t NO_TASK = std::numeric_limits<size_t>::max();
+
+    struct Node
+    {
+        Task task;
+        int priority;
+        size_t numPredecessors = 0;
+        std::vector<size_t> successors;
+    };
+
+    struct DataState
+    {
+        size_t lastWriter = NO_TASK;
+        std::vector<size_t> readers;
+    };
+
+    std::vector<Node> nodes;
+    std::unordered_map<size_t, DataState> states;
+    size_t numEdges = 0;
+};
+
+#endif // TASKGRAPH_H
@@ -0,0 +1,365 @@
+#include "thread_pool.h"
+
+#include "profiler.h"
+#include "numa.h"
+
+#include <algorithm>
+#include <string>
+#include <stdexcept>
+
+namespace
+{
+constexpr size_t CHUNKS_PER_THREAD = 4;
+
+thread_local const ThreadPool* currentPool = nullptr;
+thread_local size_t currentQueue = 0;
+
+// Growable ring of tasks, so the queues stop allocating once they have seen their peak size
+template <typename T>
+class TaskDeque
+{
+public:
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    void pushBack(T value)
+    {
+        if (count == slots.size())
+            grow();
+
+        slots[(head + count) % slots.size()] = std::move(value);
+        ++count;
+    }
+
+    T popBack()
+    {
+        --count;
+        return std::move(slots[(head + count) % slots.size()]);
+    }
+
+    T popFront()
+    {
+        T value = std::move(slots[head]);
+        head = (head + 1) % slots.size();
+        --count;
+        return value;
+    }
+
+private:
+    void grow()
+    {
+        std::vector<T> larger(std::max<size_t>(2 * slots.size(), 16));
+        for (size_t index = 0; index < count; ++index)
+            larger[index] = std::move(slots[(head + index) % slots.size()]);
+
+        slots.swap(larger);
+        head = 0;
+    }
+
+    std::vector<T> slots;
+    size_t head = 0;
+    size_t count = 0;
+};
+
+std::mutex instanceMutex;
+std::unique_ptr<ThreadPool> instance;
+ThreadAffinity instanceAffinity = ThreadAffinity::None;
+}
+
+ThreadPool::TaskGroup::TaskGroup()
+    : TaskGroup(ThreadPool::getInstance())
+{
+}
+
+ThreadPool::TaskGroup::TaskGroup(ThreadPool& pool)
+    : pool(pool)
+{
+    pool.numGroups.fetch_add(1, std::memory_order_relaxed);
+}
+
+ThreadPool::TaskGroup::~TaskGroup()
+{
+    try
+    {
+        wait();
+    }
+    catch (...)
+    {
+    }
+
+    pool.numGroups.fetch_sub(1, std::memory_order_release);
+}
+
+void ThreadPool::TaskGroup::run(Task task)
+{
+    run(std::move(task), pool.getNumThreads());
+}
+
+void ThreadPool::TaskGroup::run(Task task, size_t threadIndex)
+{
+    numPending.fetch_add(1, std::memory_order_relaxed);
+
+    QueuedTask queued = { std::move(task), this };
+    if (pool.workers.empty())
+        execute(queued);
+    else if (threadIndex >= pool.getNumThreads())
+        pool.submit(std::move(queued));
+    else
+        pool.submit(std::move(queued), (threadIndex == 0) ? 0 : threadIndex - 1);
+}
+
+void ThreadPool::TaskGroup::wait()
+{
+    while (numPending.load(std::memory_order_acquire) != 0)
+        if (!pool.runPendingTask())
+            std::this_thread::yield();
+
+    std::exception_ptr error;
+    {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        std::swap(error, exception);
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+void ThreadPool::TaskGroup::complete(std::exception_ptr error)
+{
+    if (error)
+    {
+        std::lock_guard<std::mutex> lock(exceptionMutex);
+        if (!exception)
+            exception = error;
+    }
+
+    numPending.fetch_sub(1, std::memory_order_release);
+}
+
+struct ThreadPool::Queue
+{
+    std::mutex mutex;
+    TaskDeque<QueuedTask> tasks;
+};
+
+ThreadPool::ThreadPool(size_t numThreads, ThreadAffinity affinity /*= ThreadAffinity::None*/)
+    : affinity(affinity)
+{
+    if (numThreads == 0)
+        throw std::invalid_argument("The number of threads should be positive");
+
+    for (size_t index = 1; index < numThreads; ++index)
+        queues.push_back(std::make_unique<Queue>());
+
+    for (size_t index = 0; index < queues.size(); ++index)
+        workers.emplace_back(&ThreadPool::workerLoop, this, index);
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    wakeUp.notify_all();
+
+    for (std::thread& worker : workers)
+        worker.join();
+}
+
+size_t ThreadPool::getNumThreads() const
+{
+    return workers.size() + 1;
+}
+
+ThreadAffinity ThreadPool::getAffinity() const
+{
+    return affinity;
+}
+
+void ThreadPool::parallelFor(size_t begin, size_t end, size_t grain, const RangeBody& body)
+{
+    if (begin >= end)
+        return;
+
+    size_t count = end - begin;
+    grain = std::max<size_t>(grain, 1);
+
+    size_t numChunks = std::min((count + grain - 1) / grain, getNumThreads() * CHUNKS_PER_THREAD);
+    if ((numChunks <= 1) || workers.empty())
+    {
+        body(begin, end);
+        return;
+    }
+
+    size_t chunkSize = (count + numChunks - 1) / numChunks;
+
+    // Chunk tasks only capture this and their index, which keeps them inside the small buffer of std::function
+    struct Range
+    {
+        const RangeBody& body;
+        size_t begin;
+        size_t end;
+        size_t chunkSize;
+    } range = { body, begin, end, chunkSize };
+
+    // Outside the pool every chunk index goes to the same thread on each call, so the rows a thread
+    // touches first when a matrix is allocated are the rows it gets back in the kernels. The caller
+    // runs chunk 0 and the others are dealt to the workers in turn.
+    bool isWorker = currentPool == this;
+
+    TaskGroup group(*this);
+    for (size_t chunk = 1; begin + chunk * chunkSize < end; ++chunk)
+    {
+        Task task = [&range, chunk]()
+        {
+            size_t first = range.begin + chunk * range.chunkSize;
+            range.body(first, std::min(range.end, first + range.chunkSize));
+        };
+
+        if (isWorker)
+            group.run(std::move(task));
+        else
+            group.run(std::move(task), 1 + (chunk - 1) % workers.size());
+    }
+
+    body(begin, begin + chunkSize);
+    group.wait();
+}
+
+ThreadPool& ThreadPool::getInstance()
+{
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    if (!instance)
+        instance = std::make_unique<ThreadPool>(getDefaultNumThreads(), instanceAffinity);
+
+    return *instance;
+}
+
+void ThreadPool::setNumThreads(size_t numThreads)
+{
+    if (numThreads == 0)
+        numThreads = getDefaultNumThreads();
+
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    if (instance && (instance->getNumThreads() == numThreads))
+        return;
+
+    replaceInstance(numThreads, instanceAffinity);
+}
+
+void ThreadPool::setAffinity(ThreadAffinity affinity)
+{
+    std::lock_guard<std::mutex> lock(instanceMutex);
+    if (!instance || (instance->getAffinity() == affinity))
+    {
+        instanceAffinity = affinity;
+        return;
+    }
+
+    replaceInstance(instance->getNumThreads(), affinity);
+    instanceAffinity = affinity;
+}
+
+// Called with instanceMutex held
+void ThreadPool::replaceInstance(size_t numThreads, ThreadAffinity affinity)
+{
+    if (instance && ((instance->numGroups.load(std::memory_order_acquire) != 0) || (instance->numQueued.load(std::memory_order_acquire) != 0)))
+        throw std::logic_error("The thread pool can't be replaced while it is in use");
+
+    instance.reset();
+    instance = std::make_unique<ThreadPool>(numThreads, affinity);
+}
+
+size_t ThreadPool::getDefaultNumThreads()
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+void ThreadPool::submit(QueuedTask task)
+{
+    submit(std::move(task), (currentPool == this) ? currentQueue : nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size());
+}
+
+void ThreadPool::submit(QueuedTask task, size_t index)
+{
+    {
+        std::lock_guard<std::mutex> lock(queues[index]->mutex);
+        queues[index]->tasks.pushBack(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        numQueued.fetch_add(1, std::memory_order_release);
+    }
+    wakeUp.notify_one();
+}
+
+bool ThreadPool::runPendingTask()
+{
+    if (numQueued.load(std::memory_order_acquire) == 0)
+        return false;
+
+    bool isWorker = currentPool == this;
+    size_t first = isWorker ? currentQueue : 0;
+
+    QueuedTask task;
+    for (size_t offset = 0; (offset < queues.size()) && !task.group; ++offset)
+    {
+        Queue& queue = *queues[(first + offset) % queues.size()];
+
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            continue;
+
+        task = (isWorker && (offset == 0)) ? queue.tasks.popBack() : queue.tasks.popFront();
+    }
+
+    if (!task.group)
+        return false;
+
+    numQueued.fetch_sub(1, std::memory_order_relaxed);
+    execute(task);
+    return true;
+}
+
+void ThreadPool::execute(QueuedTask& task)
+{
+    std::exception_ptr error;
+    try
+    {
+        task.task();
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    // The group may be destroyed as soon as it is completed, so the task goes first
+    TaskGroup* group = task.group;
+    task = QueuedTask();
+    group->complete(error);
+}
+
+void ThreadPool::workerLoop(size_t index)
+{
+    currentPool = this;
+    currentQueue = index;
+    profiler::setThreadName("worker " + std::to_string(index + 1));
+
+    if (affinity == ThreadAffinity::NumaNodes)
+        numa::bindCurrentThreadToNode(numa::getNodeOfThread(index + 1, queues.size() + 1));
+
+    while (true)
+    {
+        if (runPendingTask())
+            continue;
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this]() { return stopping || (numQueued.load(std::memory_order_acquire) > 0); });
+        if (stopping && (numQueued.load(std::memory_order_acquire) == 0))
+            return;
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+enum class ThreadAffinity
+{
+    None,
+    // Pool threads are pinned to the cpus of a NUMA node, consecutive threads share a node
+    NumaNodes
+};
+
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+    using RangeBody = std::function<void(size_t begin, size_t end)>;
+
+    class TaskGroup
+    {
+    public:
+        TaskGroup();
+        explicit TaskGroup(ThreadPool& pool);
+        TaskGroup(const TaskGroup&) = delete;
+        ~TaskGroup();
+
+        TaskGroup& operator=(const TaskGroup&) = delete;
+
+        void run(Task task);
+        // Queues the task for the given pool thread, idle threads can still steal it
+        void run(Task task, size_t threadIndex);
+        void wait();
+
+    private:
+        friend class ThreadPool;
+
+        void complete(std::exception_ptr error);
+
+        ThreadPool& pool;
+        std::atomic<size_t> numPending{ 0 };
+        std::mutex exceptionMutex;
+        std::exception_ptr exception;
+    };
+
+    explicit ThreadPool(size_t numThreads, ThreadAffinity affinity = ThreadAffinity::None);
+    ThreadPool(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t getNumThreads() const;
+    ThreadAffinity getAffinity() const;
+
+    void parallelFor(size_t begin, size_t end, size_t grain, const RangeBody& body);
+
+    static ThreadPool& getInstance();
+    // Both replace the shared pool and invalidate references returned by getInstance, so they are meant
+    // for startup. They throw std::logic_error while a task group of the shared pool is alive.
+    static void setNumThreads(size_t numThreads);
+    static void setAffinity(ThreadAffinity affinity);
+    static size_t getDefaultNumThreads();
+
+private:
+    struct QueuedTask
+    {
+        Task task;
+        TaskGroup* group = nullptr;
+    };
+
+    struct Queue;
+
+    static void replaceInstance(size_t numThreads, ThreadAffinity affinity);
+    void submit(QueuedTask task);
+    void submit(QueuedTask task, size_t queueIndex);
+    static void execute(QueuedTask& task);
+    bool runPendingTask();
+    void workerLoop(size_t index);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> workers;
+    ThreadAffinity affinity;
+    std::atomic<size_t> numQueued{ 0 };
+    std::atomic<size_t> numGroups{ 0 };
+    std::atomic<size_t> nextQueue{ 0 };
+    std::mutex sleepMutex;
+    std::condition_variable wakeUp;
+    bool stopping = false;
+};
+
+// Takes the body by reference, so calling it does not allocate a std::function for the lambda
+template <typename Body>
+void parallelFor(size_t begin, size_t end, size_t grain, const Body& body)
+{
+    ThreadPool::getInstance().parallelFor(begin, end, grain, ThreadPool::RangeBody(std::cref(body)));
+}
+
+#endif // THREADPOOL_H
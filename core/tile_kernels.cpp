@@ -0,0 +1,91 @@
+#include "tile_kernels.h"
+
+#include <cmath>
+
+namespace kernels
+{
+void multiplySubtract(double* C, const double* A, const double* B, size_t m, size_t n, size_t depth, size_t ld)
+{
+    for (size_t i = 0; i < m; ++i)
+    {
+        for (size_t p = 0; p < depth; ++p)
+        {
+            double a = A[i * ld + p];
+            if (a == 0.0)
+                continue;
+
+            for (size_t j = 0; j < n; ++j)
+                C[i * ld + j] -= a * B[p * ld + j];
+        }
+    }
+}
+
+void multiplyTransposedSubtract(double* C, const double* A, const double* B, size_t m, size_t n, size_t depth, size_t ld)
+{
+    for (size_t i = 0; i < m; ++i)
+    {
+        for (size_t j = 0; j < n; ++j)
+        {
+            double sum = 0.0;
+            for (size_t p = 0; p < depth; ++p)
+                sum += A[i * ld + p] * B[j * ld + p];
+
+            C[i * ld + j] -= sum;
+        }
+    }
+}
+
+void solveUnitLower(const double* L, double* B, size_t m, size_t n, size_t ld)
+{
+    for (size_t i = 1; i < m; ++i)
+        for (size_t p = 0; p < i; ++p)
+        {
+            double l = L[i * ld + p];
+            for (size_t j = 0; j < n; ++j)
+                B[i * ld + j] -= l * B[p * ld + j];
+        }
+}
+
+void solveLowerTransposedRight(const double* L, double* B, size_t m, size_t n, size_t ld)
+{
+    for (size_t i = 0; i < m; ++i)
+    {
+        double* row = B + i * ld;
+        for (size_t j = 0; j < n; ++j)
+        {
+            double value = row[j];
+            for (size_t p = 0; p < j; ++p)
+                value -= row[p] * L[j * ld + p];
+
+            row[j] = value / L[j * ld + j];
+        }
+    }
+}
+
+bool factorizeCholesky(double* A, size_t n, size_t ld)
+{
+    for (size_t j = 0; j < n; ++j)
+    {
+        double diagonal = A[j * ld + j];
+        for (size_t p = 0; p < j; ++p)
+            diagonal -= A[j * ld + p] * A[j * ld + p];
+
+        if (!(diagonal > 0.0))
+            return false;
+
+        diagonal = std::sqrt(diagonal);
+        A[j * ld + j] = diagonal;
+
+        for (size_t i = j + 1; i < n; ++i)
+        {
+            double value = A[i * ld + j];
+            for (size_t p = 0; p < j; ++p)
+                value -= A[i * ld + p] * A[j * ld + p];
+
+            A[i * ld + j] = value / diagonal;
+        }
+    }
+
+    return true;
+}
+}
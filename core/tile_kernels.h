@@ -0,0 +1,21 @@
+#ifndef TILEKERNELS_H
+#define TILEKERNELS_H
+
+#include <cstddef>
+
+// Kernels on row-major square tiles that share the leading dimension ld.
+namespace kernels
+{
+// C -= A * B, where A is m x depth and B is depth x n.
+void multiplySubtract(double* C, const double* A, const double* B, size_t m, size_t n, size_t depth, size_t ld);
+// C -= A * B^T, where A is m x depth and B is n x depth.
+void multiplyTransposedSubtract(double* C, const double* A, const double* B, size_t m, size_t n, size_t depth, size_t ld);
+// B = L^-1 * B for the unit lower triangle of the m x m tile L.
+void solveUnitLower(const double* L, double* B, size_t m, size_t n, size_t ld);
+// B = B * L^-T for the lower triangle of the n x n tile L.
+void solveLowerTransposedRight(const double* L, double* B, size_t m, size_t n, size_t ld);
+// Overwrites the lower triangle of A with its Cholesky factor, returns false if A is not positive definite.
+bool factorizeCholesky(double* A, size_t n, size_t ld);
+}
+
+#endif // TILEKERNELS_H
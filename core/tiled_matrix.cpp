@@ -0,0 +1,676 @@
+#include "tiled_matrix.h"
+
+#include "profiler.h"
+#include "row_stream.h"
+#include "tile_kernels.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+namespace
+{
+constexpr char MAGIC[8] = { 'C', 'L', 'A', 'T', 'I', 'L', 'E', '1' };
+constexpr size_t HEADER_SIZE = 64;
+constexpr size_t LU_RESERVED_TILES = 4;
+}
+
+TiledMatrix::TileHandle::TileHandle(TiledMatrix& matrix, size_t tileRow, size_t tileColumn, TileAccess access /*= TileAccess::Read*/)
+    : matrix(&matrix)
+    , index(matrix.getTileIndex(tileRow, tileColumn))
+    , dirty(access != TileAccess::Read)
+    , values(matrix.acquireTile(index, access))
+    , numRows(matrix.getTileRows(tileRow))
+    , numColumns(matrix.getTileColumns(tileColumn))
+{
+}
+
+TiledMatrix::TileHandle::TileHandle(TileHandle&& other) noexcept
+    : matrix(std::exchange(other.matrix, nullptr))
+    , index(other.index)
+    , dirty(other.dirty)
+    , values(other.values)
+    , numRows(other.numRows)
+    , numColumns(other.numColumns)
+{
+}
+
+TiledMatrix::TileHandle::~TileHandle()
+{
+    if (matrix)
+        matrix->releaseTile(index, dirty);
+}
+
+double* TiledMatrix::TileHandle::data() const
+{
+    return values;
+}
+
+size_t TiledMatrix::TileHandle::getNumRows() const
+{
+    return numRows;
+}
+
+size_t TiledMatrix::TileHandle::getNumColumns() const
+{
+    return numColumns;
+}
+
+TiledMatrix::TiledMatrix(const std::string& filepath, size_t numRows, size_t numColumns, size_t tileSize /*= DEFAULT_TILE_SIZE*/, size_t memoryBudget /*= DEFAULT_MEMORY_BUDGET*/)
+    : numRows(numRows)
+    , numColumns(numColumns)
+    , tileSize(tileSize)
+{
+    if ((numRows == 0) || (numColumns == 0))
+        throw std::invalid_argument("Invalid size of matrix");
+    if (tileSize == 0)
+        throw std::invalid_argument("Invalid tile size");
+
+    file.open(filepath, std::ios_base::in | std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to create a file: " + filepath);
+
+    char header[HEADER_SIZE] = {};
+    uint64_t dimensions[3] = { numRows, numColumns, tileSize };
+    std::memcpy(header, MAGIC, sizeof(MAGIC));
+    std::memcpy(header + sizeof(MAGIC), dimensions, sizeof(dimensions));
+    file.write(header, HEADER_SIZE);
+
+    // The file gets its full size before the prefetch thread exists, so a failure here has nothing to stop
+    uint64_t numTiles = ((numRows + tileSize - 1) / tileSize) * ((numColumns + tileSize - 1) / tileSize);
+    uint64_t fileSize = HEADER_SIZE + numTiles * tileSize * tileSize * sizeof(double);
+    file.seekp(static_cast<std::streamoff>(fileSize - 1));
+    file.put(0);
+    file.flush();
+
+    if (!file)
+        throw std::invalid_argument("Failed to create a file: " + filepath);
+
+    initialize(memoryBudget);
+}
+
+TiledMatrix::TiledMatrix(const std::string& filepath, size_t memoryBudget /*= DEFAULT_MEMORY_BUDGET*/)
+{
+    if (!std::filesystem::exists(filepath))
+        throw std::invalid_argument("Failed to open the file: " + filepath);
+
+    file.open(filepath, std::ios_base::in | std::ios_base::out | std::ios_base::binary);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to open the file: " + filepath);
+
+    char header[HEADER_SIZE] = {};
+    file.read(header, HEADER_SIZE);
+    if (!file || (std::memcmp(header, MAGIC, sizeof(MAGIC)) != 0))
+        throw std::invalid_argument("Invalid tiled matrix file: " + filepath);
+
+    uint64_t dimensions[3] = {};
+    std::memcpy(dimensions, header + sizeof(MAGIC), sizeof(dimensions));
+    numRows = dimensions[0];
+    numColumns = dimensions[1];
+    tileSize = dimensions[2];
+
+    if ((numRows == 0) || (numColumns == 0) || (tileSize == 0))
+        throw std::invalid_argument("Invalid tiled matrix file: " + filepath);
+
+    initialize(memoryBudget);
+}
+
+TiledMatrix::~TiledMatrix()
+{
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        stopping = true;
+    }
+    prefetchRequested.notify_all();
+    if (prefetchThread.joinable())
+        prefetchThread.join();
+
+    try
+    {
+        flush();
+    }
+    catch (...)
+    {
+    }
+}
+
+void TiledMatrix::initialize(size_t memoryBudget)
+{
+    numTileRows = (numRows + tileSize - 1) / tileSize;
+    numTileColumns = (numColumns + tileSize - 1) / tileSize;
+    capacity = std::max<size_t>(memoryBudget / (tileSize * tileSize * sizeof(double)), 1);
+
+    prefetchThread = std::thread(&TiledMatrix::prefetchLoop, this);
+}
+
+size_t TiledMatrix::getNumRows() const
+{
+    return numRows;
+}
+
+size_t TiledMatrix::getNumColumns() const
+{
+    return numColumns;
+}
+
+size_t TiledMatrix::getTileSize() const
+{
+    return tileSize;
+}
+
+size_t TiledMatrix::getNumTileRows() const
+{
+    return numTileRows;
+}
+
+size_t TiledMatrix::getNumTileColumns() const
+{
+    return numTileColumns;
+}
+
+size_t TiledMatrix::getCacheCapacity() const
+{
+    return capacity;
+}
+
+uint64_t TiledMatrix::getBytesRead() const
+{
+    return bytesRead;
+}
+
+uint64_t TiledMatrix::getBytesWritten() const
+{
+    return bytesWritten;
+}
+
+double TiledMatrix::get(size_t rowIndex, size_t columnIndex)
+{
+    if ((rowIndex >= numRows) || (columnIndex >= numColumns))
+        throw std::out_of_range("Matrix index is out of range");
+
+    TileHandle tile(*this, rowIndex / tileSize, columnIndex / tileSize);
+    return tile.data()[(rowIndex % tileSize) * tileSize + columnIndex % tileSize];
+}
+
+void TiledMatrix::set(size_t rowIndex, size_t columnIndex, double value)
+{
+    if ((rowIndex >= numRows) || (columnIndex >= numColumns))
+        throw std::out_of_range("Matrix index is out of range");
+
+    TileHandle tile(*this, rowIndex / tileSize, columnIndex / tileSize, TileAccess::ReadWrite);
+    tile.data()[(rowIndex % tileSize) * tileSize + columnIndex % tileSize] = value;
+}
+
+void TiledMatrix::prefetch(size_t tileRow, size_t tileColumn)
+{
+    size_t index = getTileIndex(tileRow, tileColumn);
+
+    {
+        std::lock_guard<std::mutex> lock(prefetchMutex);
+        prefetchQueue.push_back(index);
+    }
+    prefetchRequested.notify_one();
+}
+
+void TiledMatrix::flush()
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    for (auto& [index, tile] : tiles)
+    {
+        if (tile->ready && tile->dirty)
+        {
+            writeTile(index, tile->values.data());
+            tile->dirty = false;
+        }
+    }
+
+    std::lock_guard<std::mutex> fileLock(fileMutex);
+    file.flush();
+}
+
+void TiledMatrix::importMatrix(const Matrix& matrix)
+{
+    if ((matrix.getNumRows() != numRows) || (matrix.getNumColumns() != numColumns))
+        throw std::invalid_argument("Matrices have different sizes");
+
+    for (size_t tileRow = 0; tileRow < numTileRows; ++tileRow)
+    {
+        for (size_t tileColumn = 0; tileColumn < numTileColumns; ++tileColumn)
+        {
+            TileHandle tile(*this, tileRow, tileColumn, TileAccess::Overwrite);
+            for (size_t i = 0; i < tile.getNumRows(); ++i)
+                for (size_t j = 0; j < tile.getNumColumns(); ++j)
+                    tile.data()[i * tileSize + j] = matrix.at(tileRow * tileSize + i, tileColumn * tileSize + j);
+        }
+    }
+}
+
+void TiledMatrix::importRows(MatrixRowStream& stream)
+{
+    if (stream.getNumColumns() != numColumns)
+        throw std::invalid_argument("Matrices have different sizes");
+
+    RowBlock block;
+    for (size_t tileRow = 0; tileRow < numTileRows; ++tileRow)
+    {
+        if (!stream.readBlock(block, tileSize) || (block.numRows != getTileRows(tileRow)))
+            throw std::invalid_argument("The row stream ended before the matrix was filled");
+
+        for (size_t tileColumn = 0; tileColumn < numTileColumns; ++tileColumn)
+        {
+            TileHandle tile(*this, tileRow, tileColumn, TileAccess::Overwrite);
+            for (size_t i = 0; i < tile.getNumRows(); ++i)
+                std::copy_n(block.row(i) + tileColumn * tileSize, tile.getNumColumns(), tile.data() + i * tileSize);
+        }
+    }
+}
+
+Matrix TiledMatrix::toMatrix()
+{
+    Matrix matrix(static_cast<int>(numRows), static_cast<int>(numColumns));
+
+    for (size_t tileRow = 0; tileRow < numTileRows; ++tileRow)
+    {
+        for (size_t tileColumn = 0; tileColumn < numTileColumns; ++tileColumn)
+        {
+            TileHandle tile(*this, tileRow, tileColumn);
+            for (size_t i = 0; i < tile.getNumRows(); ++i)
+                for (size_t j = 0; j < tile.getNumColumns(); ++j)
+                    matrix.at(tileRow * tileSize + i, tileColumn * tileSize + j) = tile.data()[i * tileSize + j];
+        }
+    }
+
+    return matrix;
+}
+
+std::vector<size_t> TiledMatrix::factorizeLU()
+{
+    if (numRows != numColumns)
+        throw std::invalid_argument("Only square matrices can be factorized");
+
+    size_t numTiles = numTileRows;
+    if (capacity < numTiles + LU_RESERVED_TILES)
+        throw std::invalid_argument("Memory budget is too small for the out-of-core LU factorization");
+
+    size_t panelWidth = std::max<size_t>((capacity - LU_RESERVED_TILES) / numTiles, 1);
+    std::vector<size_t> pivots(numRows);
+
+    for (size_t firstColumn = 0; firstColumn < numTiles; firstColumn += panelWidth)
+    {
+        size_t lastColumn = std::min(numTiles, firstColumn + panelWidth);
+
+        std::vector<TileHandle> panel;
+        panel.reserve((lastColumn - firstColumn) * numTiles);
+        for (size_t j = firstColumn; j < lastColumn; ++j)
+            for (size_t i = 0; i < numTiles; ++i)
+                panel.emplace_back(*this, i, j, TileAccess::ReadWrite);
+
+        auto tile = [&](size_t i, size_t j) { return panel[(j - firstColumn) * numTiles + i].data(); };
+
+        auto applyPivots = [&](size_t j, size_t step)
+        {
+            size_t width = getTileColumns(j);
+            for (size_t row = step * tileSize; row < std::min(numRows, (step + 1) * tileSize); ++row)
+            {
+                size_t pivot = pivots[row];
+                if (pivot == row)
+                    continue;
+
+                double* first = tile(row / tileSize, j) + (row % tileSize) * tileSize;
+                double* second = tile(pivot / tileSize, j) + (pivot % tileSize) * tileSize;
+                std::swap_ranges(first, first + width, second);
+            }
+        };
+
+        for (size_t k = 0; k < firstColumn; ++k)
+        {
+            PROFILE_SCOPE("trailing_update");
+            size_t depth = getTileColumns(k);
+
+            {
+                TileHandle diagonal(*this, k, k);
+                for (size_t j = firstColumn; j < lastColumn; ++j)
+                {
+                    applyPivots(j, k);
+                    kernels::solveUnitLower(diagonal.data(), tile(k, j), depth, getTileColumns(j), tileSize);
+                }
+            }
+
+            for (size_t i = k + 1; i < numTiles; ++i)
+            {
+                if (i + 1 < numTiles)
+                    prefetch(i + 1, k);
+                else if (k + 1 < firstColumn)
+                    prefetch(k + 1, k + 1);
+
+                TileHandle lower(*this, i, k);
+                for (size_t j = firstColumn; j < lastColumn; ++j)
+                    kernels::multiplySubtract(tile(i, j), lower.data(), tile(k, j), getTileRows(i), getTileColumns(j), depth, tileSize);
+            }
+        }
+
+        for (size_t j = firstColumn; j < lastColumn; ++j)
+        {
+            PROFILE_SCOPE("panel_factorization");
+            size_t width = getTileColumns(j);
+
+            for (size_t k = firstColumn; k < j; ++k)
+            {
+                applyPivots(j, k);
+                kernels::solveUnitLower(tile(k, k), tile(k, j), getTileColumns(k), width, tileSize);
+                for (size_t i = k + 1; i < numTiles; ++i)
+                    kernels::multiplySubtract(tile(i, j), tile(i, k), tile(k, j), getTileRows(i), width, getTileColumns(k), tileSize);
+            }
+
+            auto element = [&](size_t row, size_t column) -> double& { return tile(row / tileSize, j)[(row % tileSize) * tileSize + column]; };
+
+            for (size_t column = 0; column < width; ++column)
+            {
+                size_t diagonal = j * tileSize + column;
+
+                size_t pivot = diagonal;
+                for (size_t row = diagonal + 1; row < numRows; ++row)
+                    if (std::abs(element(row, column)) > std::abs(element(pivot, column)))
+                        pivot = row;
+
+                pivots[diagonal] = pivot;
+                if (pivot != diagonal)
+                    std::swap_ranges(&element(diagonal, 0), &element(diagonal, 0) + width, &element(pivot, 0));
+
+                double pivotValue = element(diagonal, column);
+                if (pivotValue == 0.0)
+                    throw std::runtime_error("Matrix is singular");
+
+                for (size_t row = diagonal + 1; row < numRows; ++row)
+                {
+                    double* values = &element(row, 0);
+                    const double* pivotRow = &element(diagonal, 0);
+
+                    values[column] /= pivotValue;
+                    for (size_t c = column + 1; c < width; ++c)
+                        values[c] -= values[column] * pivotRow[c];
+                }
+            }
+        }
+    }
+
+    flush();
+    return pivots;
+}
+
+Vector TiledMatrix::solveLU(const std::vector<size_t>& pivots, const Vector& b)
+{
+    if ((numRows != numColumns) || (pivots.size() != numRows) || (b.size() != numRows))
+        throw std::invalid_argument("Wrong size of the right-hand side");
+
+    std::vector<double> y(b.begin(), b.end());
+    size_t numTiles = numTileRows;
+
+    for (size_t k = 0; k < numTiles; ++k)
+    {
+        size_t first = k * tileSize;
+        size_t depth = getTileRows(k);
+
+        for (size_t row = first; row < first + depth; ++row)
+            std::swap(y[row], y[pivots[row]]);
+
+        {
+            TileHandle diagonal(*this, k, k);
+            for (size_t i = 1; i < depth; ++i)
+                for (size_t p = 0; p < i; ++p)
+                    y[first + i] -= diagonal.data()[i * tileSize + p] * y[first + p];
+        }
+
+        for (size_t i = k + 1; i < numTiles; ++i)
+        {
+            if (i + 1 < numTiles)
+                prefetch(i + 1, k);
+
+            TileHandle lower(*this, i, k);
+            for (size_t r = 0; r < lower.getNumRows(); ++r)
+                for (size_t p = 0; p < depth; ++p)
+                    y[i * tileSize + r] -= lower.data()[r * tileSize + p] * y[first + p];
+        }
+    }
+
+    for (size_t k = numTiles; k-- > 0;)
+    {
+        size_t first = k * tileSize;
+        size_t depth = getTileRows(k);
+
+        {
+            TileHandle diagonal(*this, k, k);
+            for (size_t i = depth; i-- > 0;)
+            {
+                for (size_t p = i + 1; p < depth; ++p)
+                    y[first + i] -= diagonal.data()[i * tileSize + p] * y[first + p];
+
+                y[first + i] /= diagonal.data()[i * tileSize + i];
+            }
+        }
+
+        for (size_t i = 0; i < k; ++i)
+        {
+            if (i + 1 < k)
+                prefetch(i + 1, k);
+
+            TileHandle upper(*this, i, k);
+            for (size_t r = 0; r < upper.getNumRows(); ++r)
+                for (size_t p = 0; p < depth; ++p)
+                    y[i * tileSize + r] -= upper.data()[r * tileSize + p] * y[first + p];
+        }
+    }
+
+    Vector x(static_cast<int>(numRows));
+    std::copy(y.begin(), y.end(), x.begin());
+    return x;
+}
+
+Vector TiledMatrix::solve(const Vector& b)
+{
+    return solveLU(factorizeLU(), b);
+}
+
+size_t TiledMatrix::getTileIndex(size_t tileRow, size_t tileColumn) const
+{
+    if ((tileRow >= numTileRows) || (tileColumn >= numTileColumns))
+        throw std::out_of_range("Tile index is out of range");
+
+    return tileRow * numTileColumns + tileColumn;
+}
+
+size_t TiledMatrix::getTileRows(size_t tileRow) const
+{
+    return std::min(tileSize, numRows - tileRow * tileSize);
+}
+
+size_t TiledMatrix::getTileColumns(size_t tileColumn) const
+{
+    return std::min(tileSize, numColumns - tileColumn * tileSize);
+}
+
+double* TiledMatrix::acquireTile(size_t index, TileAccess access)
+{
+    std::unique_lock<std::mutex> lock(cacheMutex);
+
+    while (true)
+    {
+        auto it = tiles.find(index);
+        if (it == tiles.end())
+            break;
+
+        CachedTile* tile = it->second.get();
+        if (!tile->ready)
+        {
+            tileReady.wait(lock);
+            continue;
+        }
+
+        if (tile->pins++ == 0)
+            lru.erase(tile->lruPosition);
+
+        return tile->values.data();
+    }
+
+    makeRoom();
+
+    auto entry = std::make_unique<CachedTile>();
+    CachedTile* tile = entry.get();
+    tile->pins = 1;
+    tiles.emplace(index, std::move(entry));
+    lock.unlock();
+
+    try
+    {
+        tile->values.resize(tileSize * tileSize);
+        if (access != TileAccess::Overwrite)
+            readTile(index, tile->values.data());
+    }
+    catch (...)
+    {
+        lock.lock();
+        tiles.erase(index);
+        tileReady.notify_all();
+        throw;
+    }
+
+    lock.lock();
+    tile->ready = true;
+    tileReady.notify_all();
+
+    return tile->values.data();
+}
+
+void TiledMatrix::releaseTile(size_t index, bool dirty)
+{
+    std::lock_guard<std::mutex> lock(cacheMutex);
+
+    CachedTile* tile = tiles.at(index).get();
+    tile->dirty = tile->dirty || dirty;
+
+    if (--tile->pins == 0)
+    {
+        lru.push_front(index);
+        tile->lruPosition = lru.begin();
+    }
+}
+
+void TiledMatrix::makeRoom()
+{
+    while ((tiles.size() >= capacity) && !lru.empty())
+    {
+        size_t victim = lru.back();
+        lru.pop_back();
+
+        auto it = tiles.find(victim);
+        if (it->second->dirty)
+            writeTile(victim, it->second->values.data());
+
+        tiles.erase(it);
+    }
+}
+
+void TiledMatrix::readTile(size_t index, double* destination)
+{
+    PROFILE_SCOPE("read_tile");
+    size_t tileBytes = tileSize * tileSize * sizeof(double);
+
+    std::lock_guard<std::mutex> lock(fileMutex);
+    file.seekg(static_cast<std::streamoff>(HEADER_SIZE + index * tileBytes));
+    file.read(reinterpret_cast<char*>(destination), static_cast<std::streamsize>(tileBytes));
+    if (!file)
+    {
+        file.clear();
+        throw std::runtime_error("Failed to read a tile of the matrix file");
+    }
+
+    bytesRead += tileBytes;
+}
+
+void TiledMatrix::writeTile(size_t index, const double* source)
+{
+    PROFILE_SCOPE("write_tile");
+    size_t tileBytes = tileSize * tileSize * sizeof(double);
+
+    std::lock_guard<std::mutex> lock(fileMutex);
+    file.seekp(static_cast<std::streamoff>(HEADER_SIZE + index * tileBytes));
+    file.write(reinterpret_cast<const char*>(source), static_cast<std::streamsize>(tileBytes));
+    if (!file)
+    {
+        file.clear();
+        throw std::runtime_error("Failed to write a tile of the matrix file");
+    }
+
+    bytesWritten += tileBytes;
+}
+
+void TiledMatrix::prefetchLoop()
+{
+    profiler::setThreadName("prefetch");
+
+    while (true)
+    {
+        size_t index = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(prefetchMutex);
+            prefetchRequested.wait(lock, [this]() { return stopping || !prefetchQueue.empty(); });
+            if (stopping)
+                return;
+
+            index = prefetchQueue.front();
+            prefetchQueue.pop_front();
+        }
+
+        try
+        {
+            prefetchTile(index);
+        }
+        catch (...)
+        {
+        }
+    }
+}
+
+void TiledMatrix::prefetchTile(size_t index)
+{
+    std::unique_lock<std::mutex> lock(cacheMutex);
+
+    if (tiles.count(index) != 0)
+        return;
+
+    makeRoom();
+    if (tiles.size() >= capacity)
+        return;
+
+    auto entry = std::make_unique<CachedTile>();
+    CachedTile* tile = entry.get();
+    tiles.emplace(index, std::move(entry));
+    lock.unlock();
+
+    try
+    {
+        tile->values.resize(tileSize * tileSize);
+        readTile(index, tile->values.data());
+    }
+    catch (...)
+    {
+        lock.lock();
+        tiles.erase(index);
+        tileReady.notify_all();
+        throw;
+    }
+
+    lock.lock();
+    tile->ready = true;
+    if (tile->pins == 0)
+    {
+        lru.push_front(index);
+        tile->lruPosition = lru.begin();
+    }
+    tileReady.notify_all();
+}
@@ -0,0 +1,140 @@
+#ifndef TILEDMATRIX_H
+#define TILEDMATRIX_H
+
+#include "matrix.h"
+#include "vector.h"
+#include "aligned_memory.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class MatrixRowStream;
+
+enum class TileAccess
+{
+    Read,
+    ReadWrite,
+    Overwrite
+};
+
+class TiledMatrix
+{
+public:
+    static constexpr size_t DEFAULT_TILE_SIZE = 256;
+    static constexpr size_t DEFAULT_MEMORY_BUDGET = size_t(256) << 20;
+
+    class TileHandle
+    {
+    public:
+        TileHandle(TiledMatrix& matrix, size_t tileRow, size_t tileColumn, TileAccess access = TileAccess::Read);
+        TileHandle(const TileHandle&) = delete;
+        TileHandle(TileHandle&& other) noexcept;
+        ~TileHandle();
+
+        TileHandle& operator=(const TileHandle&) = delete;
+        TileHandle& operator=(TileHandle&&) = delete;
+
+        double* data() const;
+        size_t getNumRows() const;
+        size_t getNumColumns() const;
+
+    private:
+        TiledMatrix* matrix;
+        size_t index;
+        bool dirty;
+        double* values;
+        size_t numRows;
+        size_t numColumns;
+    };
+
+    TiledMatrix(const std::string& filepath, size_t numRows, size_t numColumns, size_t tileSize = DEFAULT_TILE_SIZE, size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+    explicit TiledMatrix(const std::string& filepath, size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+    TiledMatrix(const TiledMatrix&) = delete;
+    ~TiledMatrix();
+
+    TiledMatrix& operator=(const TiledMatrix&) = delete;
+
+    size_t getNumRows() const;
+    size_t getNumColumns() const;
+    size_t getTileSize() const;
+    size_t getNumTileRows() const;
+    size_t getNumTileColumns() const;
+    size_t getCacheCapacity() const;
+
+    uint64_t getBytesRead() const;
+    uint64_t getBytesWritten() const;
+
+    double get(size_t rowIndex, size_t columnIndex);
+    void set(size_t rowIndex, size_t columnIndex, double value);
+
+    void prefetch(size_t tileRow, size_t tileColumn);
+    void flush();
+
+    void importMatrix(const Matrix& matrix);
+    void importRows(MatrixRowStream& stream);
+    Matrix toMatrix();
+
+    std::vector<size_t> factorizeLU();
+    Vector solveLU(const std::vector<size_t>& pivots, const Vector& b);
+    Vector solve(const Vector& b);
+
+private:
+    struct CachedTile
+    {
+        AlignedVector<double> values;
+        size_t pins = 0;
+        bool dirty = false;
+        bool ready = false;
+        std::list<size_t>::iterator lruPosition;
+    };
+
+    void initialize(size_t memoryBudget);
+
+    size_t getTileIndex(size_t tileRow, size_t tileColumn) const;
+    size_t getTileRows(size_t tileRow) const;
+    size_t getTileColumns(size_t tileColumn) const;
+
+    double* acquireTile(size_t index, TileAccess access);
+    void releaseTile(size_t index, bool dirty);
+    void makeRoom();
+    void readTile(size_t index, double* destination);
+    void writeTile(size_t index, const double* source);
+
+    void prefetchLoop();
+    void prefetchTile(size_t index);
+
+    size_t numRows = 0;
+    size_t numColumns = 0;
+    size_t tileSize = 0;
+    size_t numTileRows = 0;
+    size_t numTileColumns = 0;
+    size_t capacity = 0;
+
+    std::fstream file;
+    std::mutex fileMutex;
+    std::atomic<uint64_t> bytesRead{0};
+    std::atomic<uint64_t> bytesWritten{0};
+
+    std::unordered_map<size_t, std::unique_ptr<CachedTile>> tiles;
+    std::list<size_t> lru;
+    std::mutex cacheMutex;
+    std::condition_variable tileReady;
+
+    std::deque<size_t> prefetchQueue;
+    std::mutex prefetchMutex;
+    std::condition_variable prefetchRequested;
+    bool stopping = false;
+    std::thread prefetchThread;
+};
+
+#endif // TILEDMATRIX_H
@@ -0,0 +1,296 @@
+#include "vector.h"
+
+#include "mapped_file.h"
+#include "reduction.h"
+
+#include <filesystem>
+#include <stdexcept>
+#include <fstream>
+#include <cmath>
+#include <utility>
+
+namespace
+{
+constexpr size_t ELEMENTS_PER_BLOCK = 1 << 14;
+}
+
+Vector::Vector(int size)
+{
+    if (size <= 0)
+        throw std::invalid_argument("Invalid vector size");
+
+    data.assign(size, 0.0);
+    resetView();
+}
+
+Vector::Vector(int size, double value)
+{
+    if (size <= 0)
+        throw std::invalid_argument("Invalid vector size");
+
+    data.assign(size, value);
+    resetView();
+}
+
+Vector::Vector(const Vector& other)
+{
+    *this = other;
+}
+
+Vector::Vector(Vector&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+Vector::Vector(std::shared_ptr<MappedFile> mapping, double* values, size_t size)
+    : values(values)
+    , length(size)
+    , mapping(std::move(mapping))
+    , shared(!this->mapping->isWritable())
+{
+}
+
+Vector& Vector::operator=(const Vector& other)
+{
+    if (this == &other)
+        return *this;
+
+    if (other.shared)
+    {
+        data.clear();
+        values = other.values;
+        length = other.length;
+        mapping = other.mapping;
+        shared = true;
+    }
+    else
+    {
+        data.assign(other.values, other.values + other.length);
+        mapping.reset();
+        shared = false;
+        resetView();
+    }
+
+    return *this;
+}
+
+Vector& Vector::operator=(Vector&& other) noexcept
+{
+    if (this == &other)
+        return *this;
+
+    data = std::move(other.data);
+    values = std::exchange(other.values, nullptr);
+    length = std::exchange(other.length, 0);
+    mapping = std::move(other.mapping);
+    shared = std::exchange(other.shared, false);
+
+    return *this;
+}
+
+Vector& Vector::operator*=(double factor)
+{
+    return *this = *this * factor;
+}
+
+double& Vector::operator[](size_t index)
+{
+    if (shared)
+        detach();
+
+    return values[index];
+}
+
+double Vector::operator[](size_t index) const
+{
+    return values[index];
+}
+
+size_t Vector::size() const
+{
+    return length;
+}
+
+double Vector::at(size_t index) const
+{
+    if (index >= length)
+        throw std::out_of_range("Vector index is out of range");
+
+    return values[index];
+}
+
+double& Vector::at(size_t index)
+{
+    if (index >= length)
+        throw std::out_of_range("Vector index is out of range");
+
+    if (shared)
+        detach();
+
+    return values[index];
+}
+
+double* Vector::begin()
+{
+    if (shared)
+        detach();
+
+    return values;
+}
+
+double* Vector::end()
+{
+    if (shared)
+        detach();
+
+    return values + length;
+}
+
+const double* Vector::begin() const
+{
+    return values;
+}
+
+const double* Vector::end() const
+{
+    return values + length;
+}
+
+void Vector::pushBack(double value)
+{
+    detach();
+
+    data.push_back(value);
+    resetView();
+}
+
+void Vector::insert(size_t index, double value)
+{
+    checkIndex(index);
+    detach();
+
+    auto it = data.cbegin() + index;
+    data.insert(it, value);
+    resetView();
+}
+
+void Vector::remove(size_t index)
+{
+    checkIndex(index);
+    detach();
+
+    auto it = data.cbegin() + index;
+    data.erase(it);
+    resetView();
+}
+
+bool Vector::isMapped() const
+{
+    return mapping != nullptr;
+}
+
+void Vector::adviseAccess(AccessPattern pattern) const
+{
+    if (mapping)
+        mapping->advise(values, length * sizeof(double), pattern);
+}
+
+double Vector::calculateEuclidianNorm() const
+{
+    double result = parallelSum(0, length, ELEMENTS_PER_BLOCK, [this](size_t first, size_t last)
+    {
+        double sum = 0.0;
+        for (size_t i = first; i < last; i++)
+            sum += values[i] * values[i];
+
+        return sum;
+    });
+
+    return std::sqrt(result);
+}
+
+Vector Vector::readFromFile(const std::string &filepath)
+{
+    if (std::filesystem::path(filepath).extension() == ".npy")
+        return readFromNpy(filepath);
+
+    if (!std::filesystem::exists(filepath))
+        throw std::invalid_argument("File doesn't exist");
+
+    std::ifstream file(filepath);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to open the file");
+
+    Vector vector;
+
+    std::string line;
+    while(std::getline(file, line))
+        vector.pushBack(std::stod(line));
+
+    return vector;
+}
+
+void Vector::writeToFile(const Vector &vector, const std::string &filepath)
+{
+    if (std::filesystem::path(filepath).extension() == ".npy")
+    {
+        writeToNpy(vector, filepath);
+        return;
+    }
+
+    std::ofstream file(filepath);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to create a file");
+
+    for (const auto& value : vector)
+        file << value << std::endl;
+}
+
+Vector Vector::readFromNpy(const std::string& filepath)
+{
+    MappedFile file(filepath);
+    npy::Header header = npy::parseHeader(file.data(), file.size());
+
+    size_t numDimensions = header.shape.size();
+    bool isColumn = (numDimensions == 2) && ((header.shape[0] == 1) || (header.shape[1] == 1));
+    if ((numDimensions != 1) && !isColumn)
+        throw std::invalid_argument("Only 1-D arrays can be loaded as a vector: " + filepath);
+
+    Vector vector(static_cast<int>(header.numElements()));
+    npy::readValues(file.data() + header.dataOffset, header, vector.size(), vector.begin());
+
+    return vector;
+}
+
+void Vector::writeToNpy(const Vector& vector, const std::string& filepath, npy::DataType type /*= npy::DataType::Float64*/)
+{
+    std::ofstream file(filepath, std::ios_base::binary | std::ios_base::trunc);
+    if (!file.is_open())
+        throw std::invalid_argument("Failed to create a file");
+
+    npy::writeHeader(file, type, npy::Order::C, { vector.size() });
+    npy::writeValues(file, vector.begin(), vector.size(), type);
+}
+
+void Vector::checkIndex(size_t index)
+{
+    if (index >= length)
+        throw std::out_of_range("Vector: Index out of range");
+}
+
+void Vector::detach()
+{
+    if (!mapping)
+        return;
+
+    data.assign(values, values + length);
+    mapping.reset();
+    shared = false;
+    resetView();
+}
+
+void Vector::resetView()
+{
+    values = data.data();
+    length = data.size();
+}
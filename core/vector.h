@@ -0,0 +1,132 @@
+#ifndef VECTOR_H
+#define VECTOR_H
+
+#include "npy.h"
+#include "mapped_file.h"
+#include "aligned_memory.h"
+#include "expression.h"
+
+#include <vector>
+#include <string>
+#include <memory>
+
+class Vector
+{
+public:
+    Vector() = default;
+    explicit Vector(int size);
+    Vector(int size, double value);
+    Vector(const Vector& other);
+    Vector(Vector&& other) noexcept;
+
+    template <typename Expression, typename = std::enable_if_t<expression::isExpression<Expression> && std::is_same_v<expression::ResultType<Expression>, Vector>>>
+    Vector(Expression&& expression);
+
+    Vector& operator=(const Vector& other);
+    Vector& operator=(Vector&& other) noexcept;
+
+    template <typename Expression, typename = std::enable_if_t<expression::isExpression<Expression> && std::is_same_v<expression::ResultType<Expression>, Vector>>>
+    Vector& operator=(Expression&& expression);
+
+    template <typename T, typename = std::enable_if_t<std::is_same_v<expression::ResultType<T>, Vector>>>
+    Vector& operator+=(T&& other);
+    template <typename T, typename = std::enable_if_t<std::is_same_v<expression::ResultType<T>, Vector>>>
+    Vector& operator-=(T&& other);
+    Vector& operator*=(double factor);
+
+    template <typename T, typename = std::enable_if_t<std::is_same_v<expression::ResultType<T>, Vector>>>
+    Vector& addScaled(T&& other, double factor);
+    double& operator[](size_t index);
+    double operator[](size_t index) const;
+
+    size_t size() const;
+    double at(size_t index) const;
+    double& at(size_t index);
+
+    double* begin();
+    double* end();
+    const double* begin() const;
+    const double* end() const;
+
+    void pushBack(double value);
+    void insert(size_t index, double value);
+    void remove(size_t index);
+
+    bool isMapped() const;
+    void adviseAccess(AccessPattern pattern) const;
+
+    double calculateEuclidianNorm() const;
+
+    static Vector readFromFile(const std::string& filepath);
+    static void writeToFile(const Vector& vector, const std::string& filepath);
+    static Vector readFromNpy(const std::string& filepath);
+    static void writeToNpy(const Vector& vector, const std::string& filepath, npy::DataType type = npy::DataType::Float64);
+
+private:
+    friend class Matrix;
+
+    Vector(std::shared_ptr<MappedFile> mapping, double* values, size_t size);
+
+    void checkIndex(size_t index);
+    void detach();
+    void resetView();
+
+    // Owned values are cache-line aligned, views into a mapped file keep the alignment of the file
+    AlignedVector<double> data;
+    double* values = nullptr;
+    size_t length = 0;
+    std::shared_ptr<MappedFile> mapping;
+    bool shared = false;
+};
+
+template <typename Expression, typename>
+Vector::Vector(Expression&& expression)
+{
+    *this = std::forward<Expression>(expression);
+}
+
+template <typename Expression, typename>
+Vector& Vector::operator=(Expression&& expression)
+{
+    size_t numColumns = expression.getNumColumns();
+    if (size() == numColumns)
+    {
+        expression::evaluate(*this, expression);
+        return *this;
+    }
+
+    Vector* storage = nullptr;
+    if constexpr (expression::isExpiring<Expression>)
+        storage = expression.getReusableStorage();
+
+    if (!storage)
+    {
+        *this = Vector(static_cast<int>(numColumns));
+        expression::evaluate(*this, expression);
+        return *this;
+    }
+
+    expression::evaluate(*storage, expression);
+    *this = std::move(*storage);
+    return *this;
+}
+
+template <typename T, typename>
+Vector& Vector::operator+=(T&& other)
+{
+    return *this = *this + std::forward<T>(other);
+}
+
+template <typename T, typename>
+Vector& Vector::operator-=(T&& other)
+{
+    return *this = *this - std::forward<T>(other);
+}
+
+template <typename T, typename>
+Vector& Vector::addScaled(T&& other, double factor)
+{
+    return *this = *this + std::forward<T>(other) * factor;
+}
+
+#endif // VECTOR_H
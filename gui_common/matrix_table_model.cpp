@@ -0,0 +1,240 @@
+#include "matrix_table_model.h"
+
+#include <QStringList>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace
+{
+constexpr int EDIT_PRECISION = 15;
+
+std::vector<std::vector<double>> parseBlock(const QString& text)
+{
+    QStringList lines = text.split('\n');
+    while (!lines.isEmpty() && lines.back().trimmed().isEmpty())
+        lines.removeLast();
+
+    std::vector<std::vector<double>> values;
+    for (const QString& line : lines)
+    {
+        std::vector<double> row;
+        for (const QString& cell : line.split('\t'))
+        {
+            bool ok = false;
+            double value = cell.trimmed().toDouble(&ok);
+            if (!ok)
+                throw std::invalid_argument("Failed to parse the pasted value: " + cell.toStdString());
+
+            row.push_back(value);
+        }
+
+        values.push_back(std::move(row));
+    }
+
+    return values;
+}
+}
+
+NumericTableModel::NumericTableModel(QObject *parent)
+    : QAbstractTableModel(parent)
+{
+}
+
+void NumericTableModel::setEditable(bool editable)
+{
+    this->editable = editable;
+}
+
+bool NumericTableModel::isEditable() const
+{
+    return editable;
+}
+
+QVariant NumericTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+
+    if (role == Qt::DisplayRole)
+        return QString::number(getValue(index.row(), index.column()));
+    if (role == Qt::EditRole)
+        return QString::number(getValue(index.row(), index.column()), 'g', EDIT_PRECISION);
+
+    return QVariant();
+}
+
+bool NumericTableModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if (!index.isValid() || (role != Qt::EditRole))
+        return false;
+
+    bool ok = false;
+    double number = value.toString().toDouble(&ok);
+    if (!ok)
+        return false;
+
+    setValue(index.row(), index.column(), number);
+    emit dataChanged(index, index, { Qt::DisplayRole, Qt::EditRole });
+
+    return true;
+}
+
+Qt::ItemFlags NumericTableModel::flags(const QModelIndex& index) const
+{
+    Qt::ItemFlags flags = QAbstractTableModel::flags(index);
+    if (editable && index.isValid())
+        flags |= Qt::ItemIsEditable;
+
+    return flags;
+}
+
+QString NumericTableModel::getText(int firstRow, int firstColumn, int lastRow, int lastColumn) const
+{
+    QString text;
+
+    for (int rowIndex = firstRow; rowIndex <= lastRow; ++rowIndex)
+    {
+        for (int columnIndex = firstColumn; columnIndex <= lastColumn; ++columnIndex)
+        {
+            text += QString::number(getValue(rowIndex, columnIndex), 'g', EDIT_PRECISION);
+            text += (columnIndex == lastColumn) ? '\n' : '\t';
+        }
+    }
+
+    return text;
+}
+
+void NumericTableModel::setValues(int firstRow, int firstColumn, const std::vector<std::vector<double>>& values)
+{
+    if (!editable)
+        throw std::runtime_error("The table is read-only");
+    if (values.empty())
+        return;
+
+    int lastRow = firstRow + static_cast<int>(values.size()) - 1;
+    int lastColumn = firstColumn;
+    for (const auto& row : values)
+        lastColumn = std::max(lastColumn, firstColumn + static_cast<int>(row.size()) - 1);
+
+    if ((firstRow < 0) || (firstColumn < 0) || (lastRow >= rowCount()) || (lastColumn >= columnCount()))
+        throw std::invalid_argument("The pasted block does not fit into the table");
+
+    for (size_t i = 0; i < values.size(); ++i)
+        for (size_t j = 0; j < values[i].size(); ++j)
+            setValue(firstRow + static_cast<int>(i), firstColumn + static_cast<int>(j), values[i][j]);
+
+    emit dataChanged(index(firstRow, firstColumn), index(lastRow, lastColumn), { Qt::DisplayRole, Qt::EditRole });
+}
+
+void NumericTableModel::setText(int firstRow, int firstColumn, const QString& text)
+{
+    setValues(firstRow, firstColumn, parseBlock(text));
+}
+
+void NumericTableModel::fillDown(int firstRow, int firstColumn, int lastRow, int lastColumn)
+{
+    if (!editable)
+        throw std::runtime_error("The table is read-only");
+    if ((firstRow < 0) || (firstColumn < 0) || (lastRow >= rowCount()) || (lastColumn >= columnCount()))
+        throw std::invalid_argument("The selection is out of the table");
+    if (firstRow >= lastRow)
+        return;
+
+    for (int columnIndex = firstColumn; columnIndex <= lastColumn; ++columnIndex)
+    {
+        double value = getValue(firstRow, columnIndex);
+        for (int rowIndex = firstRow + 1; rowIndex <= lastRow; ++rowIndex)
+            setValue(rowIndex, columnIndex, value);
+    }
+
+    emit dataChanged(index(firstRow + 1, firstColumn), index(lastRow, lastColumn), { Qt::DisplayRole, Qt::EditRole });
+}
+
+MatrixTableModel::MatrixTableModel(QObject *parent)
+    : NumericTableModel(parent)
+{
+}
+
+void MatrixTableModel::setMatrix(Matrix* matrix)
+{
+    beginResetModel();
+    this->matrix = matrix;
+    endResetModel();
+}
+
+Matrix* MatrixTableModel::getMatrix() const
+{
+    return matrix;
+}
+
+int MatrixTableModel::rowCount(const QModelIndex& parent) const
+{
+    if (!matrix || parent.isValid())
+        return 0;
+
+    return static_cast<int>(matrix->getNumRows());
+}
+
+int MatrixTableModel::columnCount(const QModelIndex& parent) const
+{
+    if (!matrix || parent.isValid() || (matrix->getNumRows() == 0))
+        return 0;
+
+    return static_cast<int>(matrix->getNumColumns());
+}
+
+double MatrixTableModel::getValue(int rowIndex, int columnIndex) const
+{
+    const Matrix& values = *matrix;
+    return values.at(rowIndex, columnIndex);
+}
+
+void MatrixTableModel::setValue(int rowIndex, int columnIndex, double value)
+{
+    matrix->at(rowIndex, columnIndex) = value;
+}
+
+VectorTableModel::VectorTableModel(QObject *parent)
+    : NumericTableModel(parent)
+{
+}
+
+void VectorTableModel::setVector(Vector* vector)
+{
+    beginResetModel();
+    this->vector = vector;
+    endResetModel();
+}
+
+Vector* VectorTableModel::getVector() const
+{
+    return vector;
+}
+
+int VectorTableModel::rowCount(const QModelIndex& parent) const
+{
+    if (!vector || parent.isValid())
+        return 0;
+
+    return static_cast<int>(vector->size());
+}
+
+int VectorTableModel::columnCount(const QModelIndex& parent) const
+{
+    if (!vector || parent.isValid())
+        return 0;
+
+    return 1;
+}
+
+double VectorTableModel::getValue(int rowIndex, int /*columnIndex*/) const
+{
+    const Vector& values = *vector;
+    return values[rowIndex];
+}
+
+void VectorTableModel::setValue(int rowIndex, int /*columnIndex*/, double value)
+{
+    (*vector)[rowIndex] = value;
+}
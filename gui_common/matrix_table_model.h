@@ -0,0 +1,80 @@
+#ifndef MATRIXTABLEMODEL_H
+#define MATRIXTABLEMODEL_H
+
+#include "matrix.h"
+#include "vector.h"
+
+#include <QAbstractTableModel>
+
+#include <vector>
+
+class NumericTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit NumericTableModel(QObject *parent = nullptr);
+
+    void setEditable(bool editable);
+    bool isEditable() const;
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+    QString getText(int firstRow, int firstColumn, int lastRow, int lastColumn) const;
+    void setValues(int firstRow, int firstColumn, const std::vector<std::vector<double>>& values);
+    void setText(int firstRow, int firstColumn, const QString& text);
+    void fillDown(int firstRow, int firstColumn, int lastRow, int lastColumn);
+
+protected:
+    virtual double getValue(int rowIndex, int columnIndex) const = 0;
+    virtual void setValue(int rowIndex, int columnIndex, double value) = 0;
+
+private:
+    bool editable = true;
+};
+
+class MatrixTableModel : public NumericTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit MatrixTableModel(QObject *parent = nullptr);
+
+    void setMatrix(Matrix* matrix);
+    Matrix* getMatrix() const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+protected:
+    double getValue(int rowIndex, int columnIndex) const override;
+    void setValue(int rowIndex, int columnIndex, double value) override;
+
+private:
+    Matrix* matrix = nullptr;
+};
+
+class VectorTableModel : public NumericTableModel
+{
+    Q_OBJECT
+
+public:
+    explicit VectorTableModel(QObject *parent = nullptr);
+
+    void setVector(Vector* vector);
+    Vector* getVector() const;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+protected:
+    double getValue(int rowIndex, int columnIndex) const override;
+    void setValue(int rowIndex, int columnIndex, double value) override;
+
+private:
+    Vector* vector = nullptr;
+};
+
+#endif // MATRIXTABLEMODEL_H
@@ -0,0 +1,116 @@
+#include "matrix_table_view.h"
+
+#include "matrix_table_model.h"
+#include "helpers.h"
+
+#include <QApplication>
+#include <QClipboard>
+#include <QKeyEvent>
+#include <QItemSelectionModel>
+
+#include <algorithm>
+
+MatrixTableView::MatrixTableView(QWidget *parent)
+    : QTableView(parent)
+{
+    setSelectionMode(QAbstractItemView::ContiguousSelection);
+}
+
+void MatrixTableView::copySelection()
+{
+    NumericTableModel* model = getModel();
+
+    int firstRow = 0, firstColumn = 0, lastRow = 0, lastColumn = 0;
+    if (!model || !getSelectionBounds(firstRow, firstColumn, lastRow, lastColumn))
+        return;
+
+    QApplication::clipboard()->setText(model->getText(firstRow, firstColumn, lastRow, lastColumn));
+}
+
+void MatrixTableView::pasteSelection()
+{
+    try
+    {
+        NumericTableModel* model = getModel();
+        if (!model || !model->isEditable())
+            return;
+
+        int firstRow = 0, firstColumn = 0, lastRow = 0, lastColumn = 0;
+        if (!getSelectionBounds(firstRow, firstColumn, lastRow, lastColumn))
+            return;
+
+        model->setText(firstRow, firstColumn, QApplication::clipboard()->text());
+    }
+    catch(const std::exception& ex)
+    {
+        helpers::showError(ex.what());
+    }
+}
+
+void MatrixTableView::fillDownSelection()
+{
+    try
+    {
+        NumericTableModel* model = getModel();
+        if (!model || !model->isEditable())
+            return;
+
+        int firstRow = 0, firstColumn = 0, lastRow = 0, lastColumn = 0;
+        if (!getSelectionBounds(firstRow, firstColumn, lastRow, lastColumn))
+            return;
+
+        model->fillDown(firstRow, firstColumn, lastRow, lastColumn);
+    }
+    catch(const std::exception& ex)
+    {
+        helpers::showError(ex.what());
+    }
+}
+
+void MatrixTableView::keyPressEvent(QKeyEvent* event)
+{
+    if (event->matches(QKeySequence::Copy))
+        copySelection();
+    else if (event->matches(QKeySequence::Paste))
+        pasteSelection();
+    else if ((event->key() == Qt::Key_D) && (event->modifiers() == Qt::ControlModifier))
+        fillDownSelection();
+    else
+        QTableView::keyPressEvent(event);
+}
+
+NumericTableModel* MatrixTableView::getModel() const
+{
+    return qobject_cast<NumericTableModel*>(model());
+}
+
+bool MatrixTableView::getSelectionBounds(int& firstRow, int& firstColumn, int& lastRow, int& lastColumn) const
+{
+    QItemSelection selection = selectionModel() ? selectionModel()->selection() : QItemSelection();
+
+    if (selection.isEmpty())
+    {
+        QModelIndex current = currentIndex();
+        if (!current.isValid())
+            return false;
+
+        firstRow = lastRow = current.row();
+        firstColumn = lastColumn = current.column();
+        return true;
+    }
+
+    firstRow = selection.front().top();
+    firstColumn = selection.front().left();
+    lastRow = selection.front().bottom();
+    lastColumn = selection.front().right();
+
+    for (const QItemSelectionRange& range : selection)
+    {
+        firstRow = std::min(firstRow, range.top());
+        firstColumn = std::min(firstColumn, range.left());
+        lastRow = std::max(lastRow, range.bottom());
+        lastColumn = std::max(lastColumn, range.right());
+    }
+
+    return true;
+}
@@ -0,0 +1,28 @@
+#ifndef MATRIXTABLEVIEW_H
+#define MATRIXTABLEVIEW_H
+
+#include <QTableView>
+
+class NumericTableModel;
+
+class MatrixTableView : public QTableView
+{
+    Q_OBJECT
+
+public:
+    explicit MatrixTableView(QWidget *parent = nullptr);
+
+public slots:
+    void copySelection();
+    void pasteSelection();
+    void fillDownSelection();
+
+protected:
+    void keyPressEvent(QKeyEvent* event) override;
+
+private:
+    NumericTableModel* getModel() const;
+    bool getSelectionBounds(int& firstRow, int& firstColumn, int& lastRow, int& lastColumn) const;
+};
+
+#endif // MATRIXTABLEVIEW_H